@@ -0,0 +1,95 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "Conversion.hpp"
+#include "Emitter.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::ofstream;
+using std::ostringstream;
+using std::string;
+using std::to_string;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a key set in the shape `KeyListener` creates
+ *        for a large configuration file.
+ *
+ * @param entries This parameter specifies the number of mappings in the
+ *                returned key set. Each mapping contains 11 keys.
+ *
+ * @return A key set below `user` with `entries * 11` keys
+ */
+CppKeySet services(size_t const entries) {
+  CppKeySet keys;
+  for (size_t entry = 0; entry < entries; entry++) {
+    string const number = to_string(entry);
+    string const name = "user/service" + number;
+    keys.append(CppKey{name + "/host", KEY_VALUE,
+                       ("host-" + number + ".example.com").c_str(), KEY_END});
+    keys.append(CppKey{name + "/port", KEY_VALUE,
+                       to_string(1024 + entry % 60000).c_str(), KEY_END});
+    keys.append(
+        CppKey{name + "/description", KEY_VALUE,
+               ("Service: " + number + " # generated").c_str(), KEY_END});
+    keys.append(CppKey{name + "/owner", KEY_VALUE, "it's me", KEY_END});
+    keys.append(CppKey{name + "/ports", KEY_META, "array", "#5", KEY_END});
+    for (uintmax_t port = 0; port < 6; port++) {
+      keys.append(CppKey{name + "/ports/" + indexToArrayBaseName(port),
+                         KEY_VALUE, to_string(8000 + port).c_str(), KEY_END});
+    }
+  }
+  return keys;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  size_t const entries = argc > 1 ? std::stoul(argv[1]) : 100000;
+  string const filename = argc > 2 ? argv[2] : "/dev/null";
+
+  CppKeySet const keys = services(entries);
+  CppKey const parent{"user", KEY_END};
+  cout << "Input: " << keys.size() << " keys" << endl;
+
+  // Emitting into memory measures the emitter without any I/O
+  ostringstream memory;
+  auto start = steady_clock::now();
+  emit(keys, parent, memory);
+  auto const emitTime =
+      duration_cast<microseconds>(steady_clock::now() - start).count();
+  string const data = memory.str();
+  cout << "Output: " << data.size() << " bytes" << endl
+       << "emit (memory): " << emitTime << " µs" << endl;
+
+  ofstream file{filename, std::ios::binary};
+  if (!file) {
+    cerr << "Unable to open “" << filename << "”" << endl;
+    return EXIT_FAILURE;
+  }
+  start = steady_clock::now();
+  emit(keys, parent, file);
+  file.flush();
+  cout << "emit (file): "
+       << duration_cast<microseconds>(steady_clock::now() - start).count()
+       << " µs" << endl;
+
+  // Writing the finished data once is the lower bound for any emitter
+  start = steady_clock::now();
+  file.write(data.data(), data.size());
+  file.flush();
+  cout << "write (file): "
+       << duration_cast<microseconds>(steady_clock::now() - start).count()
+       << " µs" << endl;
+  return EXIT_SUCCESS;
+}
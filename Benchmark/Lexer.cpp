@@ -0,0 +1,133 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+#include "StreamInputStream.hpp"
+#include "UTF8InputStream.hpp"
+#include "YAMLLexer.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::make_shared;
+using std::to_string;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a configuration file with nested mappings,
+ *        sequences, quoted scalars and comments.
+ *
+ * @param entries This parameter specifies the number of mappings in the
+ *                returned data.
+ *
+ * @return A YAML document with `entries` mappings
+ */
+string configuration(size_t const entries) {
+  string text;
+  for (size_t entry = 0; entry < entries; entry++) {
+    string const number = to_string(entry);
+    text += "# Settings of service " + number + "\n";
+    text += "service" + number + ":\n";
+    text += "  name: 'service " + number + "'\n";
+    text += "  command: \"/usr/bin/service --id " + number + "\"\n";
+    text += "  port: " + to_string(1024 + entry) + " # listening port\n";
+    text += "  tags:\n";
+    for (size_t tag = 0; tag < 3; tag++) {
+      text += "    - tag" + to_string(tag) + "\n";
+    }
+  }
+  return text;
+}
+
+/**
+ * @brief This function reads all tokens of a lexer.
+ *
+ * @param lexer This parameter stores the lexer that produces the tokens.
+ *
+ * @return The number of tokens (including `EOF`)
+ */
+size_t consume(YAMLLexer &lexer) {
+  size_t tokens = 1;
+  while (lexer.nextToken()->getType() != Token::EOF) {
+    tokens++;
+  }
+  return tokens;
+}
+
+/**
+ * @brief This function measures the time the lexer core for buffers needs to
+ *        scan the given data.
+ *
+ * @param text This parameter stores the scanned data.
+ * @param runs This parameter specifies the number of measured runs.
+ *
+ * @return The average scan time in microseconds
+ */
+long long measureBuffer(string const &text, size_t const runs) {
+  auto const start = steady_clock::now();
+  for (size_t run = 0; run < runs; run++) {
+    UTF8InputStream input{text};
+    YAMLLexer lexer{&input};
+    consume(lexer);
+  }
+  return duration_cast<microseconds>(steady_clock::now() - start).count() /
+         static_cast<long long>(runs);
+}
+
+/**
+ * @brief This function measures the time the lexer core for character
+ *        streams needs to scan the given data, which it reads from a file.
+ *
+ * @param text This parameter stores the scanned data.
+ * @param runs This parameter specifies the number of measured runs.
+ *
+ * @return The average scan time in microseconds
+ */
+long long measureStream(string const &text, size_t const runs) {
+  FILE *file = tmpfile();
+  fwrite(text.data(), 1, text.size(), file);
+  fflush(file);
+
+  auto const start = steady_clock::now();
+  for (size_t run = 0; run < runs; run++) {
+    rewind(file);
+    StreamInputStream input{fileno(file), "benchmark"};
+    YAMLLexer lexer{&input};
+    lexer.setTokenFactory(make_shared<PositionTokenFactory>(true));
+    consume(lexer);
+  }
+  long long const time =
+      duration_cast<microseconds>(steady_clock::now() - start).count() /
+      static_cast<long long>(runs);
+  fclose(file);
+  return time;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  size_t const entries = argc > 1 ? std::stoul(argv[1]) : 10000;
+  size_t const runs = argc > 2 ? std::stoul(argv[2]) : 5;
+  string const text = configuration(entries);
+
+  try {
+    UTF8InputStream input{text};
+    YAMLLexer lexer{&input};
+    cout << "Input: " << consume(lexer) << " tokens, " << text.size()
+         << " bytes" << endl;
+    cout << "buffer: " << measureBuffer(text, runs) << " µs" << endl;
+    cout << "stream: " << measureStream(text, runs) << " µs" << endl;
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to scan input: " << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
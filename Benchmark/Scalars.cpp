@@ -0,0 +1,98 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+#include <iostream>
+
+#include "Parser.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::to_string;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a configuration file that mostly contains
+ *        numbers and booleans.
+ *
+ * @param entries This parameter specifies the number of mappings in the
+ *                returned data.
+ *
+ * @return A YAML document with `entries` mappings of typed values
+ */
+string metrics(size_t const entries) {
+  string text;
+  for (size_t entry = 0; entry < entries; entry++) {
+    string const number = to_string(entry);
+    text += "sensor" + number + ":\n";
+    text += "  id: " + number + "\n";
+    text += "  offset: -" + number + "." + to_string(entry % 7) + "e-3\n";
+    text += "  mask: 0x" + to_string(entry % 10) + "F\n";
+    text += "  enabled: " + string{entry % 2 ? "true" : "false"} + "\n";
+    text += "  limit: .inf\n";
+    text += "  name: sensor-" + number + "\n";
+    text += "  samples:\n";
+    for (size_t sample = 0; sample < 4; sample++) {
+      text += "    - " + to_string(entry * sample) + ".25\n";
+    }
+  }
+  return text;
+}
+
+/**
+ * @brief This function measures the time it takes to parse the given data
+ *        with the given resolution mode.
+ *
+ * @param text This parameter stores the parsed data.
+ * @param mode This parameter specifies how the parser stores the type of
+ *             scalars.
+ * @param runs This parameter specifies the number of measured runs.
+ *
+ * @return The average parse time in microseconds
+ */
+long long measure(string const &text, TypeResolution const mode,
+                  size_t const runs) {
+  Parser parser{};
+  parser.setTypeResolution(mode);
+  parser.parse(text, CppKey{"user", KEY_END}); // Warm up prediction cache
+
+  auto const start = steady_clock::now();
+  for (size_t run = 0; run < runs; run++) {
+    parser.parse(text, CppKey{"user", KEY_END});
+  }
+  return duration_cast<microseconds>(steady_clock::now() - start).count() /
+         static_cast<long long>(runs);
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  size_t const entries = argc > 1 ? std::stoul(argv[1]) : 10000;
+  size_t const runs = argc > 2 ? std::stoul(argv[2]) : 5;
+  string const text = metrics(entries);
+
+  cout << "Input: " << entries * 10 << " scalars, " << text.size() << " bytes"
+       << endl;
+  try {
+    struct {
+      char const *name;
+      TypeResolution mode;
+    } const modes[] = {{"strings", TypeResolution::NONE},
+                       {"metadata", TypeResolution::METADATA},
+                       {"binary", TypeResolution::BINARY}};
+    for (auto const &mode : modes) {
+      cout << mode.name << ": " << measure(text, mode.mode, runs) << " µs"
+           << endl;
+    }
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to parse input: " << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
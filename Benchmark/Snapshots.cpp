@@ -0,0 +1,129 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "SnapshotStore.hpp"
+
+using std::cout;
+using std::endl;
+using std::lock_guard;
+using std::string;
+using std::thread;
+using std::to_string;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
+using std::chrono::steady_clock;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates YAML data for a configuration file.
+ *
+ * @param entries This parameter specifies the number of keys in the data.
+ * @param version This parameter specifies the value of all keys.
+ *
+ * @return YAML data that stores `entries` keys below `service`
+ */
+string configuration(size_t const entries, size_t const version) {
+  string yaml = "service:\n";
+  for (size_t entry = 0; entry < entries; entry++) {
+    yaml += "  key" + to_string(entry) + ": " + to_string(version) + "\n";
+  }
+  return yaml;
+}
+
+/**
+ * @brief This function measures lookups of many threads, while another thread
+ *        reloads the data continuously.
+ *
+ * @param name This parameter stores the name of the measured strategy.
+ * @param threads This parameter specifies the number of reading threads.
+ * @param duration This parameter specifies how long the threads read.
+ * @param lookup This function looks up a key in the current tree. Each
+ *               thread calls it with its own state of type `State`.
+ * @param reload This function replaces the current tree.
+ */
+template <typename State, typename Lookup, typename Reload>
+void measure(string const &name, size_t const threads,
+             milliseconds const duration, Lookup lookup, Reload reload) {
+  atomic<bool> done{false};
+  atomic<size_t> lookups{0};
+  vector<thread> readers;
+  for (size_t index = 0; index < threads; index++) {
+    readers.emplace_back([&, index]() {
+      State state{};
+      string const key = "user/service/key" + to_string(index);
+      size_t count = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        lookup(state, key);
+        count++;
+      }
+      lookups += count;
+    });
+  }
+
+  size_t reloads = 0;
+  auto const start = steady_clock::now();
+  while (steady_clock::now() - start < duration) {
+    reload(++reloads);
+  }
+  done = true;
+  for (auto &reader : readers) {
+    reader.join();
+  }
+
+  auto const seconds =
+      duration_cast<milliseconds>(steady_clock::now() - start).count() /
+      1000.0;
+  cout << name << ": " << static_cast<size_t>(lookups / seconds)
+       << " lookups/s, " << reloads << " reloads" << endl;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  size_t const threads =
+      argc > 1 ? std::stoul(argv[1]) : thread::hardware_concurrency();
+  size_t const entries = argc > 2 ? std::stoul(argv[2]) : 1000;
+  milliseconds const duration{argc > 3 ? std::stoul(argv[3]) : 2000};
+  cout << "Readers: " << threads << ", keys: " << entries << endl;
+
+  // Both strategies parse outside of the critical section, so the numbers
+  // only differ in the cost of reading and swapping the tree
+  SnapshotStore store{configuration(entries, 0), "user"};
+  Parser parser{};
+  measure<unique_ptr<SnapshotStore::Reader>>(
+      "snapshot store", threads, duration,
+      [&store](unique_ptr<SnapshotStore::Reader> &reader, string const &key) {
+        if (!reader) {
+          reader.reset(new SnapshotStore::Reader{store.reader()});
+        }
+        string value;
+        reader->lookup(key, value);
+      },
+      [&store, entries](size_t version) {
+        store.reload(configuration(entries, version));
+      });
+
+  mutex guard;
+  unique_ptr<KeyTree> tree{
+      new KeyTree{parser.parseKeyTree(configuration(entries, 0), "user")}};
+  measure<int>(
+      "mutex", threads, duration,
+      [&guard, &tree](int &, string const &key) {
+        lock_guard<mutex> lock{guard};
+        KeyTree::Node const node = tree->lookup(key);
+        if (node != KeyTree::NONE) {
+          string const value = tree->value(node);
+        }
+      },
+      [&guard, &tree, &parser, entries](size_t version) {
+        unique_ptr<KeyTree> next{new KeyTree{
+            parser.parseKeyTree(configuration(entries, version), "user")}};
+        lock_guard<mutex> lock{guard};
+        tree.swap(next);
+      });
+  return EXIT_SUCCESS;
+}
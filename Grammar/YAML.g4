@@ -4,8 +4,12 @@ options {
   tokenVocab=YAML;
 }
 
-yaml : STREAM_START child? comment* STREAM_END EOF ;
-child : comment* (value | map | sequence) comment*;
+// The lexer removes comments or puts them on a hidden channel, so the grammar
+// does not need to mention them.
+yaml : STREAM_START child? STREAM_END EOF ;
+child : ANCHOR? (value | map | sequence)
+      | ALIAS
+      ;
 
 value : scalar ;
 scalar : PLAIN_SCALAR
@@ -15,15 +19,9 @@ scalar : PLAIN_SCALAR
 
 map : MAPPING_START pairs BLOCK_END ;
 pairs : pair+ ;
-pair : KEY key
-       VALUE
-       comment* // Match possible comment, even if there is no value (child)
-       child?
-     ;
+pair : KEY key VALUE child? ;
 key : scalar ;
 
 sequence : SEQUENCE_START elements BLOCK_END ;
 elements : element+ ;
 element : ELEMENT child ;
-
-comment : COMMENT ;
@@ -0,0 +1,172 @@
+#ifndef YANLR_CHARACTER_CLASS_HPP
+#define YANLR_CHARACTER_CLASS_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstddef>
+#include <cstdint>
+
+#include <antlr4-runtime.h>
+
+// -- Types --------------------------------------------------------------------
+
+/** This structure stores the flags of the character classes. */
+struct CharacterClass {
+  enum : uint8_t {
+    /** The character is a space. */
+    SPACE = 1 << 0,
+    /** The character is a line break. */
+    BREAK = 1 << 1,
+    /** The character is a space or a line break. */
+    BLANK = SPACE | BREAK,
+    /** The “character” is the end of the input. */
+    END = 1 << 2,
+    /**
+     * The character (`:` or `#`) ends a plain scalar, if a blank character
+     * follows.
+     */
+    INDICATOR = 1 << 3
+  };
+};
+
+/** This enumeration specifies the method that scans the next token. */
+enum class Scanner : uint8_t {
+  PLAIN,
+  END,
+  COMMENT,
+  /** The lexer scans a value indicator, if a blank character follows. */
+  VALUE,
+  /** The lexer scans a sequence element, if a blank character follows. */
+  ELEMENT,
+  DOUBLE_QUOTED,
+  SINGLE_QUOTED,
+  ANCHOR,
+  ALIAS
+};
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function determines the character class of a byte at compile
+ *        time.
+ *
+ * @param character This parameter specifies a byte.
+ *
+ * @return The flags of the classes `character` belongs to
+ */
+constexpr uint8_t classify(size_t const character) {
+  return character == ' '
+             ? CharacterClass::SPACE
+             : character == '\n'
+                   ? CharacterClass::BREAK
+                   : character == ':' || character == '#'
+                         ? CharacterClass::INDICATOR
+                         : 0;
+}
+
+/**
+ * @brief This function determines the scanner for the first byte of a token
+ *        at compile time.
+ *
+ * @param character This parameter specifies a byte.
+ *
+ * @return The scanner for tokens starting with `character`
+ */
+constexpr Scanner dispatch(size_t const character) {
+  return character == '#'
+             ? Scanner::COMMENT
+             : character == ':'
+                   ? Scanner::VALUE
+                   : character == '-'
+                         ? Scanner::ELEMENT
+                         : character == '"'
+                               ? Scanner::DOUBLE_QUOTED
+                               : character == '\''
+                                     ? Scanner::SINGLE_QUOTED
+                                     : character == '&'
+                                           ? Scanner::ANCHOR
+                                           : character == '*'
+                                                 ? Scanner::ALIAS
+                                                 : Scanner::PLAIN;
+}
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class stores the character class and scanner of the given bytes.
+ */
+template <size_t... Characters> struct CharacterTable {
+  /** This array stores the character class of each byte. */
+  static constexpr uint8_t classes[sizeof...(Characters)] = {
+      classify(Characters)...};
+
+  /** This array stores the scanner for tokens starting with each byte. */
+  static constexpr Scanner scanners[sizeof...(Characters)] = {
+      dispatch(Characters)...};
+};
+
+template <size_t... Characters>
+constexpr uint8_t CharacterTable<Characters...>::classes[];
+
+template <size_t... Characters>
+constexpr Scanner CharacterTable<Characters...>::scanners[];
+
+/**
+ * @brief This class stores the tables for the bytes `0` up to `Size - 1`.
+ *
+ * C++11 lacks `std::make_index_sequence`, so the class collects the bytes
+ * recursively.
+ */
+template <size_t Size, size_t... Characters>
+struct ByteTable : ByteTable<Size - 1, Size - 1, Characters...> {};
+
+template <size_t... Characters>
+struct ByteTable<0, Characters...> : CharacterTable<Characters...> {};
+
+/** This type stores the tables for all bytes. */
+using Bytes = ByteTable<256>;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function returns the character class of a character.
+ *
+ * @param character This parameter stores a character returned by `LA`.
+ *
+ * @return The flags of the classes `character` belongs to
+ */
+inline uint8_t characterClass(size_t const character) {
+  return character < 256
+             ? Bytes::classes[character]
+             : character == antlr4::Token::EOF ? CharacterClass::END : 0;
+}
+
+/**
+ * @brief This function checks if a character belongs to one of the given
+ *        character classes.
+ *
+ * @param character This parameter stores a character returned by `LA`.
+ * @param classes This parameter specifies the flags of the character classes.
+ *
+ * @retval true If `character` belongs to one of the classes
+ *         false Otherwise
+ */
+inline bool isClass(size_t const character, uint8_t const classes) {
+  return (characterClass(character) & classes) != 0;
+}
+
+/**
+ * @brief This function returns the scanner for the first character of a
+ *        token.
+ *
+ * @param character This parameter stores a character returned by `LA`.
+ *
+ * @return The scanner for tokens starting with `character`
+ */
+inline Scanner scannerFor(size_t const character) {
+  return character < 256
+             ? Bytes::scanners[character]
+             : character == antlr4::Token::EOF ? Scanner::END : Scanner::PLAIN;
+}
+
+#endif // YANLR_CHARACTER_CLASS_HPP
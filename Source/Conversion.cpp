@@ -0,0 +1,307 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "Conversion.hpp"
+
+using std::to_string;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function converts a given number to an array base name.
+ *
+ * @param index This number specifies the index of the array entry.
+ *
+ * @return A string representing the given indices as Elektra array name.
+ */
+string indexToArrayBaseName(uintmax_t const index) {
+  size_t digits = 1;
+
+  for (uintmax_t value = index; value > 9; digits++) {
+    value /= 10;
+  }
+
+  return "#" + string(digits - 1, '_') + to_string(index);
+}
+
+namespace {
+
+/**
+ * @brief This function appends the UTF-8 encoding of a code point to a
+ *        string.
+ *
+ * @param text This parameter stores the string that receives the encoding.
+ * @param codePoint This number specifies a Unicode code point.
+ */
+void appendUTF8(string &text, uint32_t const codePoint) {
+  if (codePoint < 0x80) {
+    text += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    text += static_cast<char>(0xC0 | (codePoint >> 6));
+    text += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    text += static_cast<char>(0xE0 | (codePoint >> 12));
+    text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    text += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    text += static_cast<char>(0xF0 | (codePoint >> 18));
+    text += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    text += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    text += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+/**
+ * @brief This function reads the hexadecimal code point of an escape
+ *        sequence (`\x`, `\u` or `\U`).
+ *
+ * @param text This parameter stores the escape sequence.
+ * @param position This number specifies the position of the first digit.
+ * @param digits This number specifies the number of digits of the sequence.
+ * @param codePoint This parameter receives the code point of the sequence.
+ *
+ * @retval true If `text` contains `digits` hexadecimal digits at `position`,
+ *              which specify a valid code point
+ *         false Otherwise
+ */
+bool readHex(string const &text, size_t const position, size_t const digits,
+             uint32_t &codePoint) {
+  codePoint = 0;
+  for (size_t index = position; index < position + digits; index++) {
+    char const digit = text[index];
+    uint32_t value;
+    if (digit >= '0' && digit <= '9') {
+      value = digit - '0';
+    } else if (digit >= 'a' && digit <= 'f') {
+      value = digit - 'a' + 10;
+    } else if (digit >= 'A' && digit <= 'F') {
+      value = digit - 'A' + 10;
+    } else {
+      return false;
+    }
+    codePoint = codePoint << 4 | value;
+  }
+  return codePoint <= 0x10FFFF;
+}
+
+/**
+ * @brief This function reads the code point of a Unicode escape sequence.
+ *
+ * UTF-8 can not encode surrogate code points. A `\u` escape sequence that
+ * stores a high surrogate is therefore only valid, if a `\u` escape sequence
+ * storing a low surrogate follows it (`\uD83D\uDE00`). The function then
+ * returns the code point of the surrogate pair.
+ *
+ * @param text This parameter stores the escape sequence.
+ * @param position This number specifies the position of the first digit.
+ * @param end This number specifies the position of the closing quote.
+ * @param digits This number specifies the number of digits of the sequence.
+ * @param codePoint This parameter receives the code point of the sequence.
+ *
+ * @return The number of characters of the escape sequence after `position`,
+ *         or 0 if the escape sequence is invalid
+ */
+size_t readCodePoint(string const &text, size_t const position,
+                     size_t const end, size_t const digits,
+                     uint32_t &codePoint) {
+  if (position + digits > end || !readHex(text, position, digits, codePoint)) {
+    return 0;
+  }
+  if (codePoint < 0xD800 || codePoint > 0xDFFF) {
+    return digits;
+  }
+
+  size_t const low = position + digits + 2;
+  uint32_t lowSurrogate;
+  if (digits != 4 || codePoint > 0xDBFF || low + 4 > end ||
+      text.compare(position + digits, 2, "\\u") != 0 ||
+      !readHex(text, low, 4, lowSurrogate) || lowSurrogate < 0xDC00 ||
+      lowSurrogate > 0xDFFF) {
+    return 0;
+  }
+  codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00);
+  return digits + 6;
+}
+
+/**
+ * @brief This function replaces the escape sequences of a double quoted
+ *        scalar.
+ *
+ * @param text This string contains a double quoted YAML scalar (including
+ *             quote characters).
+ *
+ * @return The text of the scalar without quote characters
+ */
+string unescapeDoubleQuoted(string const &text) {
+  string unescaped;
+  unescaped.reserve(text.length() - 2);
+  size_t const end = text.length() - 1;
+  for (size_t index = 1; index < end; index++) {
+    if (text[index] != '\\' || index + 1 == end) {
+      unescaped += text[index];
+      continue;
+    }
+
+    char const escape = text[++index];
+    size_t digits = 0;
+    switch (escape) {
+    case '0':
+      unescaped += '\0';
+      break;
+    case 'a':
+      unescaped += '\a';
+      break;
+    case 'b':
+      unescaped += '\b';
+      break;
+    case 't':
+      unescaped += '\t';
+      break;
+    case 'n':
+      unescaped += '\n';
+      break;
+    case 'v':
+      unescaped += '\v';
+      break;
+    case 'f':
+      unescaped += '\f';
+      break;
+    case 'r':
+      unescaped += '\r';
+      break;
+    case 'e':
+      unescaped += '\x1B';
+      break;
+    case 'N':
+      unescaped += "\xC2\x85";
+      break;
+    case '_':
+      unescaped += "\xC2\xA0";
+      break;
+    case 'L':
+      unescaped += "\xE2\x80\xA8";
+      break;
+    case 'P':
+      unescaped += "\xE2\x80\xA9";
+      break;
+    case '\r':
+    case '\n':
+      // An escaped line break joins the lines without the break and the
+      // indentation of the next line
+      if (escape == '\r' && text[index + 1] == '\n') {
+        index++;
+      }
+      while (index + 1 < end &&
+             (text[index + 1] == ' ' || text[index + 1] == '\t')) {
+        index++;
+      }
+      break;
+    case 'x':
+      digits = 2;
+      break;
+    case 'u':
+      digits = 4;
+      break;
+    case 'U':
+      digits = 8;
+      break;
+    default:
+      // This includes `\"`, `\\`, `\/`, `\ ` and a tab after a backslash
+      unescaped += escape;
+    }
+
+    if (digits == 0) {
+      continue;
+    }
+    uint32_t codePoint;
+    size_t const length =
+        readCodePoint(text, index + 1, end, digits, codePoint);
+    if (length > 0) {
+      appendUTF8(unescaped, codePoint);
+      index += length;
+    } else {
+      // Keep invalid escape sequences (such as lone surrogates) as they are
+      unescaped += '\\';
+      unescaped += escape;
+    }
+  }
+  return unescaped;
+}
+
+} // namespace
+
+/**
+ * @brief This function converts a YAML scalar to a string.
+ *
+ * @param text This string contains a YAML scalar (including quote
+ *             characters).
+ *
+ * @return A string without leading and trailing quote characters, in which
+ *         the escape sequence `''` of single quoted scalars is replaced by
+ *         `'`, and the escape sequences of double quoted scalars (`\n`,
+ *         `\"`, `\u00e9`, …) are replaced by the characters they represent
+ */
+string scalarToText(string const &text) {
+  if (text.length() == 0) {
+    return text;
+  }
+  if (*(text.begin()) == '"') {
+    return unescapeDoubleQuoted(text);
+  }
+  if (*(text.begin()) == '\'') {
+    string unescaped;
+    unescaped.reserve(text.length() - 2);
+    for (size_t index = 1; index + 1 < text.length(); index++) {
+      unescaped += text[index];
+      // Inside the quotes the lexer only accepts `'` as part of `''`
+      if (text[index] == '\'') {
+        index++;
+      }
+    }
+    return unescaped;
+  }
+  return text;
+}
+
+/**
+ * @brief This function splits an escaped key name into unescaped base names.
+ *
+ * @param name This parameter stores the key name (or a part of it) without a
+ *             leading slash.
+ *
+ * @return A list containing the unescaped base names of `name`
+ */
+vector<string> splitKeyName(string const &name) {
+  vector<string> baseNames;
+  string baseName;
+  bool escaped = false;
+  bool wasEscaped = false;
+
+  for (char const character : name) {
+    if (escaped) {
+      baseName += character;
+      escaped = false;
+      wasEscaped = true;
+    } else if (character == '\\') {
+      escaped = true;
+    } else if (character == '/') {
+      if (!baseName.empty() || wasEscaped) {
+        baseNames.push_back(baseName);
+      }
+      baseName.clear();
+      wasEscaped = false;
+    } else {
+      baseName += character;
+    }
+  }
+  if (!baseName.empty() || wasEscaped) {
+    baseNames.push_back(baseName);
+  }
+
+  // Elektra uses `%` to represent an empty base name
+  for (auto &part : baseNames) {
+    if (part == "%") {
+      part.clear();
+    }
+  }
+  return baseNames;
+}
@@ -0,0 +1,47 @@
+#ifndef YANLR_CONVERSION_HPP
+#define YANLR_CONVERSION_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function converts a given number to an array base name.
+ *
+ * @param index This number specifies the index of the array entry.
+ *
+ * @return A string representing the given indices as Elektra array name.
+ */
+string indexToArrayBaseName(uintmax_t const index);
+
+/**
+ * @brief This function converts a YAML scalar to a string.
+ *
+ * @param text This string contains a YAML scalar (including quote
+ *             characters).
+ *
+ * @return A string without leading and trailing quote characters, in which
+ *         the escape sequence `''` of single quoted scalars is replaced by
+ *         `'`, and the escape sequences of double quoted scalars (`\n`,
+ *         `\"`, `\u00e9`, …) are replaced by the characters they represent
+ */
+string scalarToText(string const &text);
+
+/**
+ * @brief This function splits an escaped key name into unescaped base names.
+ *
+ * @param name This parameter stores the key name (or a part of it) without a
+ *             leading slash.
+ *
+ * @return A list containing the unescaped base names of `name`
+ */
+vector<string> splitKeyName(string const &name);
+
+#endif // YANLR_CONVERSION_HPP
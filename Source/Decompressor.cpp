@@ -0,0 +1,358 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include <antlr4-runtime.h>
+
+#include "Decompressor.hpp"
+
+using std::current_exception;
+using std::lock_guard;
+using std::move;
+using std::rethrow_exception;
+using std::strerror;
+using std::unique_lock;
+
+using antlr4::RuntimeException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a decompressor for the given file
+ *        descriptor.
+ *
+ * The constructor reads the first bytes of the input to determine its format.
+ *
+ * @param fileDescriptor This parameter specifies the (readable) file
+ *                       descriptor that the object reads from.
+ * @param sourceName This parameter specifies the name of the input source.
+ *
+ * @throws RuntimeException If reading the input failed, or the input uses a
+ *                          format that this build does not support
+ */
+Decompressor::Decompressor(int fileDescriptor, string sourceName)
+    : descriptor{fileDescriptor}, name{move(sourceName)} {
+  // The longest magic number (Zstandard) uses 4 bytes
+  char magic[4];
+  size_t bytes;
+  while (prefix.size() < sizeof(magic) &&
+         (bytes = readRaw(magic, sizeof(magic) - prefix.size())) > 0) {
+    prefix.append(magic, bytes);
+  }
+
+  format = detect(prefix);
+#ifndef HAVE_ZSTD
+  if (format == Compression::ZSTD) {
+    throw RuntimeException("Unable to read “" + name +
+                           "”: Zstandard support is not available");
+  }
+#endif
+  if (format != Compression::NONE) {
+    producer = thread{&Decompressor::produce, this};
+  }
+}
+
+/**
+ * @brief This destructor stops the producer thread.
+ *
+ * If the producer waits for input, then the destructor waits until the input
+ * arrives or ends.
+ */
+Decompressor::~Decompressor() {
+  if (!producer.joinable()) {
+    return;
+  }
+  {
+    lock_guard<mutex> guard{lock};
+    cancelled = true;
+  }
+  changed.notify_all();
+  producer.join();
+}
+
+/**
+ * @brief This function determines the compression format of data.
+ *
+ * @param magic This parameter stores the first bytes of the data.
+ *
+ * @return The format indicated by the magic bytes at the start of `magic`
+ */
+Compression Decompressor::detect(string const &magic) {
+  if (magic.compare(0, 2, "\x1f\x8b") == 0) {
+    return Compression::GZIP;
+  }
+  if (magic.compare(0, 4, "\x28\xb5\x2f\xfd") == 0) {
+    return Compression::ZSTD;
+  }
+  return Compression::NONE;
+}
+
+/**
+ * @brief This method returns the compression format of the input.
+ *
+ * @return The format determined by the constructor
+ */
+Compression Decompressor::compression() const { return format; }
+
+/**
+ * @brief This method reads (decompressed) data.
+ *
+ * @param data This parameter specifies the location that stores the data.
+ * @param size This parameter specifies the maximum number of read bytes.
+ *
+ * @throws RuntimeException If reading the input failed, or the compressed data
+ *                          is invalid
+ *
+ * @return The number of read bytes, or `0` at the end of the data
+ */
+size_t Decompressor::read(char *data, size_t size) {
+  if (format == Compression::NONE) {
+    return readInput(data, size);
+  }
+
+  unique_lock<mutex> guard{lock};
+  for (;;) {
+    if (head != tail) {
+      // The producer does not touch published chunks, so we copy the data
+      // without holding the lock
+      Chunk const &chunk = chunks[head % CHUNKS];
+      if (offset < chunk.size) {
+        guard.unlock();
+        size_t const bytes = std::min(size, chunk.size - offset);
+        memcpy(data, chunk.data.get() + offset, bytes);
+        offset += bytes;
+        return bytes;
+      }
+      head++;
+      offset = 0;
+      changed.notify_all();
+      continue;
+    }
+    if (finished) {
+      if (error) {
+        rethrow_exception(error);
+      }
+      return 0;
+    }
+    changed.wait(guard);
+  }
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method reads raw bytes from the file descriptor.
+ *
+ * @param data This parameter specifies the location that stores the bytes.
+ * @param size This parameter specifies the maximum number of read bytes.
+ *
+ * @throws RuntimeException If reading the input failed
+ *
+ * @return The number of read bytes, or `0` at the end of the input
+ */
+size_t Decompressor::readRaw(char *data, size_t size) {
+  ssize_t bytes;
+  do {
+    bytes = ::read(descriptor, data, size);
+  } while (bytes < 0 && errno == EINTR);
+  if (bytes < 0) {
+    throw RuntimeException("Unable to read from “" + name +
+                           "”: " + strerror(errno));
+  }
+  return bytes;
+}
+
+/**
+ * @brief This method reads raw bytes, starting with the bytes stored in
+ *        `prefix`.
+ *
+ * @param data This parameter specifies the location that stores the bytes.
+ * @param size This parameter specifies the maximum number of read bytes.
+ *
+ * @throws RuntimeException If reading the input failed
+ *
+ * @return The number of read bytes, or `0` at the end of the input
+ */
+size_t Decompressor::readInput(char *data, size_t size) {
+  if (prefix.empty()) {
+    return readRaw(data, size);
+  }
+  size_t const bytes = std::min(size, prefix.size());
+  memcpy(data, prefix.data(), bytes);
+  prefix.erase(0, bytes);
+  return bytes;
+}
+
+/**
+ * @brief This method waits until the ring contains a free chunk.
+ *
+ * @return The free chunk, or `nullptr` if the consumer stopped the producer
+ */
+Decompressor::Chunk *Decompressor::nextFree() {
+  unique_lock<mutex> guard{lock};
+  changed.wait(guard, [this]() { return cancelled || tail - head < CHUNKS; });
+  if (cancelled) {
+    return nullptr;
+  }
+  Chunk *chunk = &chunks[tail % CHUNKS];
+  chunk->size = 0;
+  return chunk;
+}
+
+/**
+ * @brief This method publishes the chunk returned by the last call of
+ *        `nextFree`.
+ */
+void Decompressor::publish() {
+  {
+    lock_guard<mutex> guard{lock};
+    tail++;
+  }
+  changed.notify_all();
+}
+
+/**
+ * @brief This method decompresses gzip data into the ring.
+ *
+ * @throws RuntimeException If the input is not valid gzip data
+ */
+void Decompressor::inflateGzip() {
+  z_stream stream{};
+  // The window bits select the gzip format (`16`) with the largest window
+  if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+    throw RuntimeException("Unable to initialize gzip decompression");
+  }
+  unique_ptr<z_stream, decltype(&inflateEnd)> const cleanup{&stream,
+                                                            inflateEnd};
+  unique_ptr<char[]> input{new char[CHUNK_SIZE]};
+  bool ended = false;
+  int status = Z_OK;
+
+  Chunk *chunk = nextFree();
+  while (chunk) {
+    if (stream.avail_in == 0 && !ended) {
+      size_t const bytes = readInput(input.get(), CHUNK_SIZE);
+      ended = bytes == 0;
+      stream.next_in = reinterpret_cast<Bytef *>(input.get());
+      stream.avail_in = bytes;
+    }
+    if (stream.avail_in == 0 && ended && status == Z_STREAM_END) {
+      break;
+    }
+    if (status == Z_STREAM_END) {
+      // A gzip file may contain multiple members
+      inflateReset(&stream);
+    }
+
+    stream.next_out =
+        reinterpret_cast<Bytef *>(chunk->data.get() + chunk->size);
+    stream.avail_out = CHUNK_SIZE - chunk->size;
+    status = inflate(&stream, Z_NO_FLUSH);
+    if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+      throw RuntimeException("Invalid gzip data in “" + name + "”: " +
+                             (stream.msg ? stream.msg : zError(status)));
+    }
+    // Without more input `inflate` only makes progress with buffered output
+    if (status == Z_BUF_ERROR && stream.avail_in == 0 && ended) {
+      throw RuntimeException("The gzip data of “" + name + "” is truncated");
+    }
+    chunk->size = CHUNK_SIZE - stream.avail_out;
+    if (chunk->size == CHUNK_SIZE) {
+      publish();
+      chunk = nextFree();
+    }
+  }
+  if (chunk && chunk->size > 0) {
+    publish();
+  }
+}
+
+/**
+ * @brief This method decompresses Zstandard data into the ring.
+ *
+ * @throws RuntimeException If the input is not valid Zstandard data
+ */
+void Decompressor::decompressZstd() {
+#ifdef HAVE_ZSTD
+  unique_ptr<ZSTD_DStream, decltype(&ZSTD_freeDStream)> const stream{
+      ZSTD_createDStream(), ZSTD_freeDStream};
+  if (!stream || ZSTD_isError(ZSTD_initDStream(stream.get()))) {
+    throw RuntimeException("Unable to initialize Zstandard decompression");
+  }
+  unique_ptr<char[]> input{new char[CHUNK_SIZE]};
+  ZSTD_inBuffer in{input.get(), 0, 0};
+  bool ended = false;
+  // The decompressor returns `0` after it read a complete frame
+  size_t hint = 1;
+
+  Chunk *chunk = nextFree();
+  while (chunk) {
+    if (in.pos == in.size && !ended) {
+      in.size = readInput(input.get(), CHUNK_SIZE);
+      in.pos = 0;
+      ended = in.size == 0;
+    }
+    if (in.pos == in.size && ended && hint == 0) {
+      break;
+    }
+
+    ZSTD_outBuffer out{chunk->data.get(), CHUNK_SIZE, chunk->size};
+    hint = ZSTD_decompressStream(stream.get(), &out, &in);
+    if (ZSTD_isError(hint)) {
+      throw RuntimeException("Invalid Zstandard data in “" + name +
+                             "”: " + ZSTD_getErrorName(hint));
+    }
+    // Without more input the decompressor only makes progress with buffered
+    // output
+    if (hint != 0 && in.pos == in.size && ended && out.pos == chunk->size) {
+      throw RuntimeException("The Zstandard data of “" + name +
+                             "” is truncated");
+    }
+    chunk->size = out.pos;
+    if (chunk->size == CHUNK_SIZE) {
+      publish();
+      chunk = nextFree();
+    }
+  }
+  if (chunk && chunk->size > 0) {
+    publish();
+  }
+#else
+  throw RuntimeException("Unable to read “" + name +
+                         "”: Zstandard support is not available");
+#endif
+}
+
+/**
+ * @brief This method decompresses the whole input into the ring, until the
+ *        input ends, it is invalid or the consumer stopped the producer.
+ */
+void Decompressor::produce() {
+  exception_ptr failure;
+  try {
+    if (format == Compression::GZIP) {
+      inflateGzip();
+    } else {
+      decompressZstd();
+    }
+  } catch (...) {
+    failure = current_exception();
+  }
+
+  {
+    lock_guard<mutex> guard{lock};
+    error = failure;
+    finished = true;
+  }
+  changed.notify_all();
+}
@@ -0,0 +1,218 @@
+#ifndef YANLR_DECOMPRESSOR_HPP
+#define YANLR_DECOMPRESSOR_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+using std::condition_variable;
+using std::exception_ptr;
+using std::mutex;
+using std::string;
+using std::thread;
+using std::unique_ptr;
+
+// -- Types --------------------------------------------------------------------
+
+/** This enumeration specifies the compression formats a decompressor reads. */
+enum class Compression { NONE, GZIP, ZSTD };
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class reads data from a file descriptor and decompresses it, if
+ *        it starts with the magic bytes of gzip or Zstandard data.
+ *
+ * For compressed data a separate thread reads and decompresses the input into
+ * a small ring of chunks, while the consumer takes data out of the ring. The
+ * decompressed data therefore never occupies more than the ring, and
+ * decompression overlaps with the work of the consumer. Uncompressed data
+ * passes through without a separate thread.
+ */
+class Decompressor {
+  /** This constant specifies the number of bytes read at once. */
+  static const size_t CHUNK_SIZE = 64 * 1024;
+
+  /** This constant specifies the number of chunks in the ring. */
+  static const size_t CHUNKS = 4;
+
+  /** This structure stores a piece of the decompressed data. */
+  struct Chunk {
+    /** This array stores the data of the chunk. */
+    unique_ptr<char[]> data{new char[CHUNK_SIZE]};
+    /** This number stores the number of bytes stored in `data`. */
+    size_t size = 0;
+  };
+
+  /** This variable stores the file descriptor this object reads from. */
+  int descriptor;
+
+  /** This variable stores the name of the source this object reads. */
+  string name;
+
+  /** This variable stores the compression format of the input. */
+  Compression format = Compression::NONE;
+
+  /**
+   * This variable stores the bytes that the constructor read to determine
+   * the format of the input, and the uncompressed input read after them.
+   */
+  string prefix;
+
+  /** This ring stores the chunks of decompressed data. */
+  Chunk chunks[CHUNKS];
+
+  /** This counter stores the number of chunks taken out of the ring. */
+  size_t head = 0;
+
+  /** This counter stores the number of chunks published into the ring. */
+  size_t tail = 0;
+
+  /** This number stores the number of consumed bytes of the head chunk. */
+  size_t offset = 0;
+
+  /** This boolean specifies if the producer thread stopped. */
+  bool finished = false;
+
+  /** This boolean tells the producer thread to stop early. */
+  bool cancelled = false;
+
+  /** This variable stores the exception thrown by the producer thread. */
+  exception_ptr error;
+
+  /**
+   * This mutex protects the counters and flags shared with the producer.
+   * Waiting on a condition (instead of spinning) keeps the consumer idle,
+   * while the producer waits for slow input.
+   */
+  mutex lock;
+
+  /** This condition signals changes of the counters and flags. */
+  condition_variable changed;
+
+  /** This thread reads and decompresses the input. */
+  thread producer;
+
+  /**
+   * @brief This method reads raw bytes from the file descriptor.
+   *
+   * @param data This parameter specifies the location that stores the bytes.
+   * @param size This parameter specifies the maximum number of read bytes.
+   *
+   * @throws RuntimeException If reading the input failed
+   *
+   * @return The number of read bytes, or `0` at the end of the input
+   */
+  size_t readRaw(char *data, size_t size);
+
+  /**
+   * @brief This method reads raw bytes, starting with the bytes stored in
+   *        `prefix`.
+   *
+   * @param data This parameter specifies the location that stores the bytes.
+   * @param size This parameter specifies the maximum number of read bytes.
+   *
+   * @throws RuntimeException If reading the input failed
+   *
+   * @return The number of read bytes, or `0` at the end of the input
+   */
+  size_t readInput(char *data, size_t size);
+
+  /**
+   * @brief This method waits until the ring contains a free chunk.
+   *
+   * @return The free chunk, or `nullptr` if the consumer stopped the producer
+   */
+  Chunk *nextFree();
+
+  /**
+   * @brief This method publishes the chunk returned by the last call of
+   *        `nextFree`.
+   */
+  void publish();
+
+  /**
+   * @brief This method decompresses gzip data into the ring.
+   *
+   * @throws RuntimeException If the input is not valid gzip data
+   */
+  void inflateGzip();
+
+  /**
+   * @brief This method decompresses Zstandard data into the ring.
+   *
+   * @throws RuntimeException If the input is not valid Zstandard data
+   */
+  void decompressZstd();
+
+  /**
+   * @brief This method decompresses the whole input into the ring, until
+   *        the input ends, it is invalid or the consumer stopped the
+   *        producer.
+   */
+  void produce();
+
+public:
+  /**
+   * @brief This constructor creates a decompressor for the given file
+   *        descriptor.
+   *
+   * The constructor reads the first bytes of the input to determine its
+   * format.
+   *
+   * @param fileDescriptor This parameter specifies the (readable) file
+   *                       descriptor that the object reads from.
+   * @param sourceName This parameter specifies the name of the input source.
+   *
+   * @throws RuntimeException If reading the input failed, or the input uses
+   *                          a format that this build does not support
+   */
+  Decompressor(int fileDescriptor, string sourceName);
+
+  Decompressor(Decompressor const &) = delete;
+  Decompressor &operator=(Decompressor const &) = delete;
+
+  /**
+   * @brief This destructor stops the producer thread.
+   *
+   * If the producer waits for input, then the destructor waits until the
+   * input arrives or ends.
+   */
+  ~Decompressor();
+
+  /**
+   * @brief This function determines the compression format of data.
+   *
+   * @param magic This parameter stores the first bytes of the data.
+   *
+   * @return The format indicated by the magic bytes at the start of `magic`
+   */
+  static Compression detect(string const &magic);
+
+  /**
+   * @brief This method returns the compression format of the input.
+   *
+   * @return The format determined by the constructor
+   */
+  Compression compression() const;
+
+  /**
+   * @brief This method reads (decompressed) data.
+   *
+   * @param data This parameter specifies the location that stores the data.
+   * @param size This parameter specifies the maximum number of read bytes.
+   *
+   * @throws RuntimeException If reading the input failed, or the compressed
+   *                          data is invalid
+   *
+   * @return The number of read bytes, or `0` at the end of the data
+   */
+  size_t read(char *data, size_t size);
+};
+
+#endif // YANLR_DECOMPRESSOR_HPP
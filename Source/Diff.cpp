@@ -0,0 +1,149 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "Diff.hpp"
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function checks if Elektra stores a base name unchanged in a key
+ *        name.
+ *
+ * @param baseName This parameter stores an (unescaped) base name.
+ *
+ * @retval true If the escaped version of `baseName` is `baseName` itself
+ *         false If `baseName` might need escaping
+ */
+bool isPlain(string const &baseName) {
+  if (baseName.empty() || baseName[0] == '%' || baseName[0] == '.' ||
+      baseName.find_first_of("/\\") != string::npos) {
+    return false;
+  }
+  if (baseName[0] != '#') {
+    return true;
+  }
+  // Array base names use an underscore for every digit after the first one
+  size_t const underscores = baseName.find_first_not_of('_', 1) - 1;
+  size_t const digits = baseName.size() - 1 - underscores;
+  return underscores < baseName.size() - 1 && digits == underscores + 1 &&
+         baseName.find_first_not_of("0123456789", underscores + 1) ==
+             string::npos;
+}
+
+/**
+ * @brief This function adds a base name to a key name.
+ *
+ * @param name This parameter stores the (escaped) key name this function
+ *             modifies.
+ * @param baseName This parameter stores the (unescaped) added base name.
+ */
+void addBaseName(string &name, string const &baseName) {
+  if (isPlain(baseName)) {
+    name += '/';
+    name += baseName;
+    return;
+  }
+  // We leave the escaping of special base names to Elektra
+  CppKey key{name, KEY_END};
+  key.addBaseName(baseName);
+  name = key.getName();
+}
+
+/**
+ * @brief This function reports the differences between two subtrees.
+ *
+ * @param before This parameter stores the old tree.
+ * @param oldNode This parameter specifies the root of the old subtree or
+ *                `NONE`, if the old tree does not contain the subtree.
+ * @param after This parameter stores the new tree.
+ * @param newNode This parameter specifies the root of the new subtree or
+ *                `NONE`, if the new tree does not contain the subtree.
+ * @param name This parameter stores the (escaped) name of both roots. The
+ *             function uses the string as buffer for the names of the
+ *             children, and restores it before it returns.
+ * @param report This function receives each difference.
+ *
+ * @return The number of differences in the subtrees
+ */
+size_t compare(KeyTree const &before, KeyTree::Node const oldNode,
+               KeyTree const &after, KeyTree::Node const newNode, string &name,
+               DiffReport const &report) {
+  size_t changes = 0;
+  bool const wasKey = oldNode != KeyTree::NONE && before.isKey(oldNode);
+  bool const isKey = newNode != KeyTree::NONE && after.isKey(newNode);
+  if (wasKey && isKey) {
+    string const oldValue = before.value(oldNode);
+    string const newValue = after.value(newNode);
+    if (oldValue != newValue) {
+      report(Change::CHANGED, name, oldValue, newValue);
+      changes++;
+    }
+  } else if (wasKey) {
+    report(Change::REMOVED, name, before.value(oldNode), "");
+    changes++;
+  } else if (isKey) {
+    report(Change::ADDED, name, "", after.value(newNode));
+    changes++;
+  }
+
+  // Both trees store the children of each node ordered by base name
+  KeyTree::Node oldChild = oldNode == KeyTree::NONE
+                               ? KeyTree::NONE
+                               : before.firstChild(oldNode);
+  KeyTree::Node newChild = newNode == KeyTree::NONE
+                               ? KeyTree::NONE
+                               : after.firstChild(newNode);
+  size_t const length = name.size();
+  while (oldChild != KeyTree::NONE || newChild != KeyTree::NONE) {
+    // We take the smaller base name from one side, and the child with the
+    // same base name from the other side, if it exists
+    KeyTree::Node oldMatch = KeyTree::NONE;
+    KeyTree::Node newMatch = KeyTree::NONE;
+    string const *baseName = nullptr;
+    if (newChild == KeyTree::NONE ||
+        (oldChild != KeyTree::NONE &&
+         before.baseName(oldChild) <= after.baseName(newChild))) {
+      oldMatch = oldChild;
+      oldChild = before.nextSibling(oldChild);
+      baseName = &before.baseName(oldMatch);
+    }
+    if (newChild != KeyTree::NONE &&
+        (oldMatch == KeyTree::NONE || after.baseName(newChild) == *baseName)) {
+      newMatch = newChild;
+      newChild = after.nextSibling(newChild);
+      baseName = &after.baseName(newMatch);
+    }
+
+    addBaseName(name, *baseName);
+    changes += compare(before, oldMatch, after, newMatch, name, report);
+    name.resize(length);
+  }
+  return changes;
+}
+
+} // namespace
+
+/**
+ * @brief This function reports all keys that differ between two key trees.
+ *
+ * The function walks both trees at the same time. It visits the children of
+ * each node ordered by their base names and joins the two sorted sequences in
+ * a single pass, so it never looks up keys of one tree in the other one. The
+ * differences therefore arrive sorted by key name.
+ *
+ * Both trees have to store the children of each node ordered by base name
+ * (`KeyTree::sortChildren`), like the trees of `Parser::parseKeyTree`.
+ *
+ * @param before This parameter stores the old data.
+ * @param after This parameter stores the new data. The names of the reported
+ *              keys start with the name of the parent key of this tree.
+ * @param report This function receives each difference.
+ *
+ * @return The number of differences
+ */
+size_t diff(KeyTree const &before, KeyTree const &after,
+            DiffReport const &report) {
+  string name = after.name(KeyTree::ROOT);
+  return compare(before, KeyTree::ROOT, after, KeyTree::ROOT, name, report);
+}
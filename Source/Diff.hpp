@@ -0,0 +1,50 @@
+#ifndef YANLR_DIFF_HPP
+#define YANLR_DIFF_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <functional>
+#include <string>
+
+#include "KeyTree.hpp"
+
+using std::function;
+using std::string;
+
+// -- Types --------------------------------------------------------------------
+
+/** This enumeration specifies how a key differs between two key trees. */
+enum class Change { ADDED, REMOVED, CHANGED };
+
+/**
+ * This type stores a function that receives a single difference: the kind of
+ * change, the name of the key, the old value and the new value. Values of
+ * keys that do not exist on one side are empty.
+ */
+using DiffReport = function<void(Change const change, string const &name,
+                                 string const &before, string const &after)>;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function reports all keys that differ between two key trees.
+ *
+ * The function walks both trees at the same time. It visits the children of
+ * each node ordered by their base names and joins the two sorted sequences in
+ * a single pass, so it never looks up keys of one tree in the other one. The
+ * differences therefore arrive sorted by key name.
+ *
+ * Both trees have to store the children of each node ordered by base name
+ * (`KeyTree::sortChildren`), like the trees of `Parser::parseKeyTree`.
+ *
+ * @param before This parameter stores the old data.
+ * @param after This parameter stores the new data. The names of the reported
+ *              keys start with the name of the parent key of this tree.
+ * @param report This function receives each difference.
+ *
+ * @return The number of differences
+ */
+size_t diff(KeyTree const &before, KeyTree const &after,
+            DiffReport const &report);
+
+#endif // YANLR_DIFF_HPP
@@ -0,0 +1,467 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include <antlr4-runtime.h>
+
+#include "CharacterClass.hpp"
+#include "Conversion.hpp"
+#include "Emitter.hpp"
+#include "ScalarType.hpp"
+
+using std::string;
+using std::to_string;
+using std::vector;
+
+using antlr4::IllegalArgumentException;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/** This number specifies the size of the buffer that triggers a flush. */
+size_t const FLUSH_SIZE = 1 << 20;
+
+/**
+ * @brief This function returns the character class of a byte of a string.
+ *
+ * @param character This parameter stores a byte of a (UTF-8 encoded) string.
+ *
+ * @return The flags of the classes `character` belongs to
+ */
+uint8_t classOf(char const character) {
+  return characterClass(static_cast<unsigned char>(character));
+}
+
+/**
+ * @brief This function checks if the lexer reads the given text as a single
+ *        plain scalar.
+ *
+ * The emitter follows every scalar with `: ` or a line break, so an indicator
+ * at the end of the text counts as indicator followed by a blank character. The
+ * text `<<` needs quotes, since the listeners read a plain `<<` key as merge
+ * key.
+ *
+ * @param text This parameter stores the (unquoted) text of a scalar.
+ *
+ * @retval true If the text needs quotes
+ *         false If the text can be written as plain scalar
+ */
+bool needsQuotes(string const &text) {
+  if (text.empty() || text.front() == ' ' || text.back() == ' ' ||
+      text == "<<") {
+    return true;
+  }
+
+  Scanner const scanner =
+      scannerFor(static_cast<unsigned char>(text.front()));
+  if (scanner == Scanner::VALUE || scanner == Scanner::ELEMENT) {
+    if (text.size() == 1 || (classOf(text[1]) & CharacterClass::BLANK)) {
+      return true;
+    }
+  } else if (scanner != Scanner::PLAIN) {
+    return true;
+  }
+
+  for (size_t index = 0; index < text.size(); index++) {
+    uint8_t const characterClass = classOf(text[index]);
+    if ((characterClass & CharacterClass::BREAK) ||
+        ((characterClass & CharacterClass::INDICATOR) &&
+         (index + 1 == text.size() ||
+          (classOf(text[index + 1]) & CharacterClass::BLANK)))) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief This function checks if a text contains characters, which only
+ *        double quoted scalars can represent without changing them.
+ *
+ * Readers fold line breaks inside single quoted scalars into spaces, and YAML
+ * does not allow other control characters (except tabs) outside of escape
+ * sequences.
+ *
+ * @param text This parameter stores the (unquoted) text of a scalar.
+ *
+ * @retval true If the text needs double quotes
+ *         false Otherwise
+ */
+bool needsEscapes(string const &text) {
+  for (char const character : text) {
+    unsigned char const byte = static_cast<unsigned char>(character);
+    if ((byte < 0x20 && byte != '\t') || byte == 0x7F) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief This function checks if a key stores a value.
+ *
+ * @param key This parameter stores the checked key.
+ *
+ * @retval true If the key stores a (possibly empty) string or binary value
+ *         false If the value of the key is `null`
+ */
+bool hasValue(CppKey const &key) { return key.getStringSize() > 0; }
+
+/**
+ * @brief This function returns the text of the value of a key.
+ *
+ * @param key This parameter stores a key with a value.
+ *
+ * @throws IllegalArgumentException If the key stores a binary value, whose
+ *                                  type the function does not support
+ *
+ * @return The value of `key` as text, that `resolveScalar` maps back to the
+ *         (binary) value
+ */
+string valueText(CppKey const &key) {
+  if (!key.isBinary()) {
+    return key.getString();
+  }
+
+  string const data = key.getBinary();
+  string const type = key.getMeta<string>("type");
+  if (type == "boolean" && data.size() == sizeof(bool)) {
+    bool boolean;
+    memcpy(&boolean, data.data(), sizeof(boolean));
+    return boolean ? "true" : "false";
+  }
+  if (type == "long_long" && data.size() == sizeof(int64_t)) {
+    int64_t integer;
+    memcpy(&integer, data.data(), sizeof(integer));
+    return to_string(integer);
+  }
+  if (type == "double" && data.size() == sizeof(double)) {
+    double floating;
+    memcpy(&floating, data.data(), sizeof(floating));
+    if (std::isnan(floating)) {
+      return ".nan";
+    }
+    if (std::isinf(floating)) {
+      return floating < 0 ? "-.inf" : ".inf";
+    }
+    char number[32];
+    snprintf(number, sizeof(number), "%.17g", floating);
+    string text{number};
+    // Without a fraction or exponent the number would be an integer
+    if (text.find_first_of(".e") == string::npos) {
+      text += ".0";
+    }
+    return text;
+  }
+  throw IllegalArgumentException("The binary value of the key “" +
+                                 key.getName() +
+                                 "” has no supported type");
+}
+
+/**
+ * @brief This class writes the keys of a key set in the order of the key set.
+ */
+class Writer {
+  /** This variable stores the stream that receives the YAML data. */
+  ostream &output;
+
+  /** This variable stores YAML data, which the writer did not flush yet. */
+  string buffer;
+
+  /** This vector stores the base names of the last written node. */
+  vector<string> path;
+
+  /**
+   * This vector specifies for each level of `path` (and the level below it),
+   * if the collection at this level is a sequence.
+   */
+  vector<bool> sequences;
+
+  /**
+   * This boolean specifies if the buffer ends with an element indicator,
+   * whose mapping continues on the same line (`- key: value`).
+   */
+  bool openElement = false;
+
+  /**
+   * This variable specifies how the listener, which reads the YAML data,
+   * resolves the type of plain scalars.
+   */
+  TypeResolution resolution;
+
+  /**
+   * @brief This method writes a scalar, quoting it if necessary.
+   *
+   * @param text This parameter stores the (unquoted) text of the scalar.
+   * @param quote This parameter specifies if the method should quote the
+   *              scalar, even if the lexer reads it as the same plain scalar.
+   */
+  void writeScalar(string const &text, bool const quote = false) {
+    if (needsEscapes(text)) {
+      writeDoubleQuoted(text);
+      return;
+    }
+    if (!quote && !needsQuotes(text)) {
+      buffer += text;
+      return;
+    }
+    buffer += '\'';
+    for (char const character : text) {
+      if (character == '\'') {
+        buffer += '\'';
+      }
+      buffer += character;
+    }
+    buffer += '\'';
+  }
+
+  /**
+   * @brief This method writes a scalar as double quoted scalar.
+   *
+   * @param text This parameter stores the (unquoted) text of the scalar.
+   */
+  void writeDoubleQuoted(string const &text) {
+    buffer += '"';
+    for (char const character : text) {
+      switch (character) {
+      case '"':
+        buffer += "\\\"";
+        break;
+      case '\\':
+        buffer += "\\\\";
+        break;
+      case '\n':
+        buffer += "\\n";
+        break;
+      case '\r':
+        buffer += "\\r";
+        break;
+      default:
+        unsigned char const byte = static_cast<unsigned char>(character);
+        if ((byte < 0x20 && byte != '\t') || byte == 0x7F) {
+          char escaped[5];
+          snprintf(escaped, sizeof(escaped), "\\x%02x", byte);
+          buffer += escaped;
+        } else {
+          buffer += character;
+        }
+      }
+    }
+    buffer += '"';
+  }
+
+  /**
+   * @brief This method writes the value of a key.
+   *
+   * If the reader resolves types, then it stores plain scalars such as `1`,
+   * `true` or `~` as typed values. The method therefore quotes string values,
+   * which would change their type as plain scalar.
+   *
+   * @param key This parameter stores a key with a value.
+   */
+  void writeValue(CppKey const &key) {
+    string const text = valueText(key);
+    bool const typed = key.isBinary() || key.hasMeta("type");
+    writeScalar(text, !typed && resolution != TypeResolution::NONE &&
+                          resolveScalar(text).type != ScalarType::STRING);
+  }
+
+  /**
+   * @brief This method writes the comment metadata of a key.
+   *
+   * @param key This parameter stores the key, which might contain comments.
+   * @param depth This number specifies the level of the key below the root.
+   */
+  void writeComments(CppKey const &key, size_t const depth) {
+    for (uintmax_t index = 0;; index++) {
+      string const name = "comment/" + indexToArrayBaseName(index);
+      if (!key.hasMeta(name)) {
+        return;
+      }
+      if (openElement) {
+        buffer += '\n';
+        openElement = false;
+      }
+      buffer.append(2 * depth, ' ');
+      buffer += '#';
+      buffer += key.getMeta<string>(name);
+      buffer += '\n';
+    }
+  }
+
+  /**
+   * @brief This method writes the indentation of a new entry.
+   *
+   * @param depth This number specifies the level of the entry below the root.
+   */
+  void startEntry(size_t const depth) {
+    if (openElement) {
+      buffer += ' ';
+      openElement = false;
+    } else {
+      buffer.append(2 * depth, ' ');
+    }
+  }
+
+public:
+  /**
+   * @brief This constructor creates a writer for the given stream.
+   *
+   * @param stream This parameter specifies the stream that receives the YAML
+   *               data.
+   * @param root This parameter stores the key that stores the document.
+   * @param mode This parameter specifies how the reader of the YAML data
+   *             resolves the type of plain scalars.
+   */
+  Writer(ostream &stream, CppKey const &root, TypeResolution const mode)
+      : output(stream), resolution(mode) {
+    buffer.reserve(FLUSH_SIZE + FLUSH_SIZE / 4);
+    sequences.push_back(root && root.hasMeta("array"));
+  }
+
+  /**
+   * @brief This method writes a key and all levels above it, which the
+   *        writer did not write yet.
+   *
+   * @param key This parameter stores the written key.
+   * @param names This parameter stores the base names of `key` below the
+   *              root.
+   * @param hasChildren This parameter specifies if the key set contains keys
+   *                    below `key`.
+   *
+   * @throws IllegalArgumentException If the key stores a value and has
+   *                                  children
+   */
+  void write(CppKey const &key, vector<string> const &names,
+             bool const hasChildren) {
+    bool const value = hasValue(key);
+    if (value && hasChildren) {
+      throw IllegalArgumentException("The key “" + key.getName() +
+                                     "” stores a value and has children");
+    }
+
+    if (names.empty()) {
+      // The root stores a scalar document, or a collection we already know
+      // from `sequences`
+      writeComments(key, 0);
+      if (value) {
+        writeValue(key);
+        buffer += '\n';
+      }
+      flush();
+      return;
+    }
+
+    // Keys arrive in order, so the new key shares a prefix with the last
+    // written node, and every level below this prefix is new
+    size_t common = 0;
+    while (common < path.size() && common < names.size() &&
+           path[common] == names[common]) {
+      common++;
+    }
+    path.resize(common);
+    sequences.resize(common + 1);
+
+    for (size_t depth = common; depth < names.size(); depth++) {
+      bool const last = depth + 1 == names.size();
+      // Only the key itself stores data, the levels above it only store
+      // mappings, since parents of sequences are keys
+      if (last) {
+        writeComments(key, depth);
+      }
+      startEntry(depth);
+      if (sequences[depth]) {
+        buffer += '-';
+      } else {
+        writeScalar(names[depth]);
+        buffer += ':';
+      }
+      path.push_back(names[depth]);
+      bool const sequence = last && key.hasMeta("array");
+      sequences.push_back(sequence);
+
+      if (last && !hasChildren) {
+        if (value) {
+          buffer += ' ';
+          writeValue(key);
+        } else if (sequences[depth] || key.isBinary()) {
+          // The grammar requires data for every element, and listeners that
+          // resolve types only store `null` as binary value for `~`
+          buffer += " ~";
+        }
+        buffer += '\n';
+      } else if (sequences[depth] && !sequence) {
+        openElement = true;
+      } else {
+        buffer += '\n';
+      }
+    }
+    flush();
+  }
+
+  /**
+   * @brief This method writes the buffer to the output, if it is large
+   *        enough or `force` is true.
+   *
+   * @param force This parameter specifies if the method should write data
+   *              regardless of the size of the buffer.
+   */
+  void flush(bool const force = false) {
+    if (force || buffer.size() >= FLUSH_SIZE) {
+      output.write(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+  }
+};
+
+} // namespace
+
+/**
+ * @brief This function writes a key set as block-style YAML data.
+ *
+ * @param keys This parameter stores the written keys. The function ignores
+ *             keys that are not located at or below `parent`.
+ * @param parent This parameter specifies the key that stores the document.
+ * @param output This parameter specifies the stream that receives the YAML
+ *               data.
+ * @param resolution This parameter specifies how the reader of the YAML data
+ *                   resolves the type of plain scalars.
+ *
+ * @throws IllegalArgumentException If a key stores a value and has children,
+ *                                  or stores a binary value without a
+ *                                  supported type
+ */
+void emit(CppKeySet const &keys, CppKey const &parent, ostream &output,
+          TypeResolution const resolution) {
+  string const parentName = parent.getName();
+  // The root of a mapping does not have to be part of the key set
+  CppKey root = keys.lookup(parentName);
+  Writer writer{output, root, resolution};
+
+  ssize_t const size = keys.size();
+  ssize_t position = 0;
+  while (position < size && !keys.at(position).isBelowOrSame(parent)) {
+    position++;
+  }
+
+  while (position < size) {
+    CppKey const key = keys.at(position);
+    // The keys below `key` follow directly after it
+    for (position++;
+         position < size && !keys.at(position).isBelowOrSame(parent);
+         position++) {
+    }
+    bool const hasChildren = position < size && keys.at(position).isBelow(key);
+
+    vector<string> const names =
+        key.getName().size() > parentName.size()
+            ? splitKeyName(key.getName().substr(parentName.size()))
+            : vector<string>{};
+    writer.write(key, names, hasChildren);
+  }
+  writer.flush(true);
+}
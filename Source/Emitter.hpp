@@ -0,0 +1,51 @@
+#ifndef YANLR_EMITTER_HPP
+#define YANLR_EMITTER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <ostream>
+
+#include <kdb.hpp>
+
+#include "ScalarType.hpp"
+
+using std::ostream;
+
+using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function writes a key set as block-style YAML data.
+ *
+ * The function expects keys in the shape `KeyListener` creates them: Keys
+ * with `array` metadata store a sequence, all other keys with children store
+ * a mapping. The function writes comment metadata (`comment/#0`, …) as
+ * comments in front of the data of a key, and the binary values of typed
+ * keys as plain scalars.
+ *
+ * The function visits the keys once in the order of the key set, and writes
+ * the data into a large buffer, which it hands to `output` in one piece
+ * whenever it fills up. It only quotes a scalar, if the lexer would not read
+ * the scalar as the same plain scalar otherwise, or if the reader would
+ * resolve the plain scalar to a value of a different type. Scalars that
+ * contain line breaks or other control characters use double quotes and
+ * escape sequences.
+ *
+ * @param keys This parameter stores the written keys. The function ignores
+ *             keys that are not located at or below `parent`.
+ * @param parent This parameter specifies the key that stores the document.
+ * @param output This parameter specifies the stream that receives the YAML
+ *               data.
+ * @param resolution This parameter specifies how the reader of the YAML data
+ *                   resolves the type of plain scalars.
+ *
+ * @throws IllegalArgumentException If a key stores a value and has children,
+ *                                  or stores a binary value without a
+ *                                  supported type
+ */
+void emit(CppKeySet const &keys, CppKey const &parent, ostream &output,
+          TypeResolution const resolution = TypeResolution::NONE);
+
+#endif // YANLR_EMITTER_HPP
@@ -1,11 +1,8 @@
 // -- Imports ------------------------------------------------------------------
 
-#include <iostream>
-
 #include "ErrorListener.hpp"
 
-using std::cerr;
-using std::endl;
+using std::to_string;
 
 // -- Class --------------------------------------------------------------------
 
@@ -30,5 +27,31 @@ void ErrorListener::syntaxError(Recognizer *recognizer __attribute__((unused)),
                                 const std::string &message,
                                 std::exception_ptr error
                                 __attribute__((unused))) {
-  cerr << line << ":" << charPositionInLine << " " << message << endl;
+  messages.push_back(to_string(line) + ":" + to_string(charPositionInLine) +
+                     " " + message);
+}
+
+/**
+ * @brief This method returns the messages of all reported errors.
+ *
+ * @return A list of error messages in the order the parser reported them
+ */
+vector<string> const &ErrorListener::errors() const { return messages; }
+
+/**
+ * @brief This method removes all stored error messages.
+ */
+void ErrorListener::reset() { messages.clear(); }
+
+/**
+ * @brief This function returns the position of a token in the format of the
+ *        stored error messages.
+ *
+ * @param token This parameter stores the token.
+ *
+ * @return The line and character position of `token`
+ */
+string ErrorListener::position(Token *token) {
+  return to_string(token->getLine()) + ":" +
+         to_string(token->getCharPositionInLine());
 }
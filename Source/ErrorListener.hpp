@@ -1,3 +1,6 @@
+#ifndef YANLR_ERROR_LISTENER_HPP
+#define YANLR_ERROR_LISTENER_HPP
+
 // -- Imports ------------------------------------------------------------------
 
 #include <antlr4-runtime.h>
@@ -8,6 +11,7 @@ using antlr4::Token;
 
 using std::exception_ptr;
 using std::string;
+using std::vector;
 
 // -- Class --------------------------------------------------------------------
 
@@ -16,6 +20,9 @@ using std::string;
  */
 class ErrorListener : public BaseErrorListener {
 
+  /** This vector stores the messages of all errors reported so far. */
+  vector<string> messages;
+
   /**
    * @brief This method will be called if the parsing process fails.
    *
@@ -34,4 +41,29 @@ class ErrorListener : public BaseErrorListener {
   void syntaxError(Recognizer *recognizer, Token *offendingSymbol, size_t line,
                    size_t charPositionInLine, const string &message,
                    exception_ptr error);
+
+public:
+  /**
+   * @brief This method returns the messages of all reported errors.
+   *
+   * @return A list of error messages in the order the parser reported them
+   */
+  vector<string> const &errors() const;
+
+  /**
+   * @brief This method removes all stored error messages.
+   */
+  void reset();
+
+  /**
+   * @brief This function returns the position of a token in the format of
+   *        the stored error messages.
+   *
+   * @param token This parameter stores the token.
+   *
+   * @return The line and character position of `token`
+   */
+  static string position(Token *token);
 };
+
+#endif // YANLR_ERROR_LISTENER_HPP
@@ -0,0 +1,444 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Conversion.hpp"
+#include "ErrorListener.hpp"
+#include "JSONListener.hpp"
+#include "ScalarType.hpp"
+
+using std::to_string;
+
+using antlr4::ParseCancellationException;
+using antlr::YAML;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function checks if the given text is a valid JSON number.
+ *
+ * @param text This parameter stores the checked text.
+ *
+ * @retval true If `text` matches the number syntax of JSON
+ *         false Otherwise
+ */
+bool isJSONNumber(string const &text) {
+  size_t position = text.size() > 0 && text[0] == '-' ? 1 : 0;
+  auto const digits = [&text, &position]() {
+    size_t const start = position;
+    while (position < text.size() && text[position] >= '0' &&
+           text[position] <= '9') {
+      position++;
+    }
+    return position - start;
+  };
+
+  // The integer part must not contain leading zeros
+  bool const zero = position < text.size() && text[position] == '0';
+  size_t const integerDigits = digits();
+  if (integerDigits == 0 || (zero && integerDigits > 1)) {
+    return false;
+  }
+  if (position < text.size() && text[position] == '.') {
+    position++;
+    if (digits() == 0) {
+      return false;
+    }
+  }
+  if (position < text.size() && (text[position] | 0x20) == 'e') {
+    position++;
+    if (position < text.size() &&
+        (text[position] == '+' || text[position] == '-')) {
+      position++;
+    }
+    if (digits() == 0) {
+      return false;
+    }
+  }
+  return position == text.size();
+}
+
+/**
+ * @brief This function returns the shortest text that represents the given
+ *        floating point number exactly.
+ *
+ * @param number This parameter stores a finite number.
+ *
+ * @return The text with the fewest significant digits that converts back to
+ *         `number`
+ */
+string shortestNumber(double const number) {
+  char text[32];
+  for (int precision = 1; precision < 17; precision++) {
+    snprintf(text, sizeof(text), "%.*g", precision, number);
+    if (strtod(text, nullptr) == number) {
+      return text;
+    }
+  }
+  snprintf(text, sizeof(text), "%.17g", number);
+  return text;
+}
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This method prepares the listener for a new document.
+ *
+ * @param stream This parameter specifies the stream that receives the JSON
+ *               text. The stream has to stay valid until the listener exits
+ *               the document.
+ */
+void JSONListener::reset(ostream &stream) {
+  output = &stream;
+  buffer.clear();
+  first = stack<bool>{};
+  captures = stack<Capture>{};
+  openAnchors = 0;
+  anchors.clear();
+  inKey = false;
+  valuePending = false;
+  mergePending = false;
+  nodes = 0;
+  aliasNodes = 0;
+}
+
+/**
+ * @brief This method specifies the resource limits for a single document.
+ *
+ * The listener applies the alias limit to the number of values it writes for
+ * aliases.
+ *
+ * @param documentLimits This parameter stores the new limits.
+ */
+void JSONListener::setLimits(Limits const &documentLimits) {
+  limits = documentLimits;
+}
+
+/**
+ * @brief This function will be called after the parser exits the document.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::exitYaml(YamlContext *context __attribute__((unused))) {
+  if (nodes == 0) {
+    buffer += "null";
+  }
+  buffer += '\n';
+  output->write(buffer.data(), buffer.size());
+  buffer.clear();
+}
+
+/**
+ * @brief This function will be called after the parser enters a node.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::enterChild(ChildContext *context __attribute__((unused))) {
+  captures.push(Capture{"", 0, 0});
+}
+
+/**
+ * @brief This function will be called after the parser exits a node.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::exitChild(ChildContext *context __attribute__((unused))) {
+  Capture const &capture = captures.top();
+  if (!capture.anchor.empty()) {
+    anchors[capture.anchor] =
+        Anchor{buffer.substr(capture.start), nodes - capture.nodes};
+    openAnchors--;
+  }
+  captures.pop();
+  flush();
+}
+
+/**
+ * @brief This function will be called after the parser enters a mapping.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::enterMap(MapContext *context __attribute__((unused))) {
+  beginValue();
+  buffer += '{';
+  first.push(true);
+}
+
+/**
+ * @brief This function will be called after the parser exits a mapping.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::exitMap(MapContext *context __attribute__((unused))) {
+  buffer += '}';
+  first.pop();
+}
+
+/**
+ * @brief This function will be called after the parser exits a key-value pair.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::exitPair(PairContext *context __attribute__((unused))) {
+  // Pairs without a value store `null`
+  if (valuePending) {
+    beginValue();
+    buffer += "null";
+  }
+}
+
+/**
+ * @brief This function will be called after the parser enters a key.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::enterKey(KeyContext *context __attribute__((unused))) {
+  inKey = true;
+}
+
+/**
+ * @brief This function will be called after the parser exits a key.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::exitKey(KeyContext *context __attribute__((unused))) {
+  inKey = false;
+  valuePending = true;
+}
+
+/**
+ * @brief This function will be called after the parser enters a sequence.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::enterSequence(SequenceContext *context
+                                 __attribute__((unused))) {
+  beginValue();
+  buffer += '[';
+  first.push(true);
+}
+
+/**
+ * @brief This function will be called after the parser exits a sequence.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::exitSequence(SequenceContext *context
+                                __attribute__((unused))) {
+  buffer += ']';
+  first.pop();
+}
+
+/**
+ * @brief This function will be called after the parser enters an element of a
+ *        sequence.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void JSONListener::enterElement(ElementContext *context
+                                __attribute__((unused))) {
+  writeSeparator();
+}
+
+/**
+ * @brief This function will be called for every token the parser matches.
+ *
+ * @param node This parameter stores the matched token.
+ */
+void JSONListener::visitTerminal(TerminalNode *node) {
+  Token *token = node->getSymbol();
+  switch (token->getType()) {
+  case YAML::PLAIN_SCALAR:
+  case YAML::SINGLE_QUOTED_SCALAR:
+  case YAML::DOUBLE_QUOTED_SCALAR:
+    if (!inKey) {
+      beginValue();
+      writeScalar(token);
+    } else if (token->getType() == YAML::PLAIN_SCALAR &&
+               token->getText() == "<<") {
+      // We wait for the value, to decide if we merge it into the mapping
+      mergePending = true;
+    } else {
+      writeSeparator();
+      writeString(scalarToText(token->getText()));
+      buffer += ':';
+    }
+    break;
+  case YAML::ANCHOR:
+    // The captured text of an anchored mapping must start with `{`
+    writeMergeKey();
+    captures.top().anchor = token->getText().substr(1);
+    captures.top().start = buffer.size();
+    captures.top().nodes = nodes;
+    openAnchors++;
+    break;
+  case YAML::ALIAS:
+    writeAlias(token);
+    break;
+  }
+  flush();
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method writes a comma, if the current collection already
+ *        contains a member.
+ */
+void JSONListener::writeSeparator() {
+  if (!first.top()) {
+    buffer += ',';
+  }
+  first.top() = false;
+}
+
+/**
+ * @brief This method writes a string as JSON string.
+ *
+ * @param text This parameter stores the (UTF-8 encoded) string.
+ */
+void JSONListener::writeString(string const &text) {
+  buffer += '"';
+  for (char const character : text) {
+    switch (character) {
+    case '"':
+      buffer += "\\\"";
+      break;
+    case '\\':
+      buffer += "\\\\";
+      break;
+    case '\n':
+      buffer += "\\n";
+      break;
+    case '\t':
+      buffer += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(character) < 0x20) {
+        char escaped[7];
+        snprintf(escaped, sizeof(escaped), "\\u%04x", character);
+        buffer += escaped;
+      } else {
+        buffer += character;
+      }
+    }
+  }
+  buffer += '"';
+}
+
+/**
+ * @brief This method writes the postponed name of a merge key.
+ */
+void JSONListener::writeMergeKey() {
+  if (mergePending) {
+    mergePending = false;
+    writeSeparator();
+    buffer += "\"<<\":";
+  }
+}
+
+/**
+ * @brief This method prepares writing a value.
+ */
+void JSONListener::beginValue() {
+  writeMergeKey();
+  valuePending = false;
+  nodes++;
+}
+
+/**
+ * @brief This method writes a scalar value.
+ *
+ * @param token This parameter stores the scalar.
+ */
+void JSONListener::writeScalar(Token *token) {
+  string const text = scalarToText(token->getText());
+  if (token->getType() != YAML::PLAIN_SCALAR) {
+    writeString(text);
+    return;
+  }
+
+  ResolvedScalar const scalar = resolveScalar(text);
+  switch (scalar.type) {
+  case ScalarType::NULL_VALUE:
+    buffer += "null";
+    break;
+  case ScalarType::BOOLEAN:
+    buffer += scalar.boolean ? "true" : "false";
+    break;
+  case ScalarType::INTEGER:
+    buffer += to_string(scalar.integer);
+    break;
+  case ScalarType::FLOAT:
+    // JSON has no representation for infinity and NaN. We keep the text of
+    // the scalar, if JSON uses the same notation.
+    if (std::isfinite(scalar.floating)) {
+      buffer += isJSONNumber(text) ? text : shortestNumber(scalar.floating);
+    } else {
+      writeString(text);
+    }
+    break;
+  default:
+    writeString(text);
+  }
+}
+
+/**
+ * @brief This method writes the JSON text of an anchor for an alias.
+ *
+ * @param token This parameter stores the alias.
+ *
+ * @throws ParseCancellationException If the anchor does not exist or the alias
+ *                                    exceeds the alias limit
+ */
+void JSONListener::writeAlias(Token *token) {
+  string const name = token->getText().substr(1);
+  string const position = ErrorListener::position(token) + " ";
+  auto anchor = anchors.find(name);
+  if (anchor == anchors.end()) {
+    throw ParseCancellationException(position + "Unknown alias “" + name +
+                                     "”");
+  }
+  if (anchor->second.nodes > limits.aliasKeys - aliasNodes) {
+    throw ParseCancellationException(
+        position + "Expanding alias “" + name + "” exceeds the limit of " +
+        to_string(limits.aliasKeys) + " values created by aliases");
+  }
+  aliasNodes += anchor->second.nodes;
+
+  string const &json = anchor->second.json;
+  if (mergePending && json.front() == '{') {
+    // We merge the pairs of the anchored mapping into the current mapping
+    mergePending = false;
+    valuePending = false;
+    nodes += anchor->second.nodes;
+    if (json.size() > 2) {
+      writeSeparator();
+      buffer.append(json, 1, json.size() - 2);
+    }
+    return;
+  }
+
+  beginValue();
+  nodes += anchor->second.nodes - 1;
+  buffer += json;
+}
+
+/**
+ * @brief This method writes the buffer to the output, if it is large enough
+ *        and does not contain parts of an open anchored node.
+ */
+void JSONListener::flush() {
+  if (openAnchors == 0 && buffer.size() >= FLUSH_SIZE) {
+    output->write(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+}
@@ -0,0 +1,270 @@
+#ifndef YANLR_JSON_LISTENER_HPP
+#define YANLR_JSON_LISTENER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <ostream>
+#include <stack>
+#include <unordered_map>
+
+#include "YAMLBaseListener.h"
+
+#include "Limits.hpp"
+
+using std::ostream;
+using std::stack;
+using std::string;
+using std::unordered_map;
+
+using antlr4::Token;
+using antlr4::tree::TerminalNode;
+
+using antlr::YAMLBaseListener;
+using YamlContext = antlr::YAML::YamlContext;
+using ChildContext = antlr::YAML::ChildContext;
+using MapContext = antlr::YAML::MapContext;
+using PairContext = antlr::YAML::PairContext;
+using KeyContext = antlr::YAML::KeyContext;
+using SequenceContext = antlr::YAML::SequenceContext;
+using ElementContext = antlr::YAML::ElementContext;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class converts YAML data to JSON while the grammar parser
+ *        matches the data.
+ *
+ * The listener only uses the order of rule and token events, and never looks
+ * at the children of a rule context. It therefore also works as parse
+ * listener of a grammar parser that does not build a parse tree. Apart from
+ * the JSON text of anchored nodes, the listener itself only stores data for
+ * each level of nesting. The grammar parser still creates a rule context for
+ * every rule and a terminal node for every token it reports to the listener
+ * (see `Parser::toJSON`).
+ *
+ * Mappings keep the order of their pairs. Plain scalars turn into `null`,
+ * booleans or numbers, where possible. Merge keys (`<<`) that refer to an
+ * anchored mapping insert the pairs of the mapping; JSON readers therefore
+ * see duplicate names, if the mapping also contains one of these keys.
+ */
+class JSONListener : public YAMLBaseListener {
+  /** This number specifies the size of the buffer that triggers a flush. */
+  static size_t const FLUSH_SIZE = 1 << 16;
+
+  /** This structure stores the start of an anchored node. */
+  struct Capture {
+    /** This variable stores the name of the anchor or an empty string. */
+    string anchor;
+    /** This number stores the offset of the node in `buffer`. */
+    size_t start;
+    /** This number stores the value of `nodes` before the node. */
+    size_t nodes;
+  };
+
+  /** This structure stores the JSON text of an anchored node. */
+  struct Anchor {
+    /** This variable stores the JSON text of the node. */
+    string json;
+    /** This number stores the number of values inside the node. */
+    size_t nodes;
+  };
+
+  /** This variable stores the stream that receives the JSON text. */
+  ostream *output = nullptr;
+
+  /** This variable stores JSON text, which the listener did not flush yet. */
+  string buffer;
+
+  /**
+   * This stack stores for each open collection, if the listener did not
+   * write any member of the collection yet.
+   */
+  stack<bool> first;
+
+  /** This stack stores the (possible) anchor of each open node. */
+  stack<Capture> captures;
+
+  /**
+   * This counter stores the number of open anchored nodes. The listener does
+   * not flush `buffer`, while this number is positive.
+   */
+  size_t openAnchors = 0;
+
+  /** This map stores the JSON text of each anchor. */
+  unordered_map<string, Anchor> anchors;
+
+  /** This boolean specifies if the current scalar is a key. */
+  bool inKey = false;
+
+  /** This boolean specifies if the current pair has no value yet. */
+  bool valuePending = false;
+
+  /**
+   * This boolean specifies if the current pair is a merge key, which the
+   * listener did not write yet.
+   */
+  bool mergePending = false;
+
+  /** This number stores the number of values written so far. */
+  size_t nodes = 0;
+
+  /** This number stores the number of values written for aliases. */
+  size_t aliasNodes = 0;
+
+  /** This variable stores the resource limits of the current document. */
+  Limits limits;
+
+  /**
+   * @brief This method writes a comma, if the current collection already
+   *        contains a member.
+   */
+  void writeSeparator();
+
+  /**
+   * @brief This method writes a string as JSON string.
+   *
+   * @param text This parameter stores the (UTF-8 encoded) string.
+   */
+  void writeString(string const &text);
+
+  /**
+   * @brief This method writes the postponed name of a merge key.
+   */
+  void writeMergeKey();
+
+  /**
+   * @brief This method prepares writing a value.
+   */
+  void beginValue();
+
+  /**
+   * @brief This method writes a scalar value.
+   *
+   * @param token This parameter stores the scalar.
+   */
+  void writeScalar(Token *token);
+
+  /**
+   * @brief This method writes the JSON text of an anchor for an alias.
+   *
+   * @param token This parameter stores the alias.
+   *
+   * @throws ParseCancellationException If the anchor does not exist or the
+   *                                    alias exceeds the alias limit
+   */
+  void writeAlias(Token *token);
+
+  /**
+   * @brief This method writes the buffer to the output, if it is large
+   *        enough and does not contain parts of an open anchored node.
+   */
+  void flush();
+
+public:
+  /**
+   * @brief This method prepares the listener for a new document.
+   *
+   * @param stream This parameter specifies the stream that receives the JSON
+   *               text. The stream has to stay valid until the listener
+   *               exits the document.
+   */
+  void reset(ostream &stream);
+
+  /**
+   * @brief This method specifies the resource limits for a single document.
+   *
+   * The listener applies the alias limit to the number of values it writes
+   * for aliases.
+   *
+   * @param documentLimits This parameter stores the new limits.
+   */
+  void setLimits(Limits const &documentLimits);
+
+  /**
+   * @brief This function will be called after the parser exits the document.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitYaml(YamlContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a node.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterChild(ChildContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a node.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitChild(ChildContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a mapping.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterMap(MapContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a mapping.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitMap(MapContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a key-value
+   *        pair.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitPair(PairContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a key.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterKey(KeyContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a key.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitKey(KeyContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a sequence.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterSequence(SequenceContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a sequence.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitSequence(SequenceContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters an element
+   *        of a sequence.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterElement(ElementContext *context) override;
+
+  /**
+   * @brief This function will be called for every token the parser matches.
+   *
+   * @param node This parameter stores the matched token.
+   */
+  void visitTerminal(TerminalNode *node) override;
+};
+
+#endif // YANLR_JSON_LISTENER_HPP
@@ -0,0 +1,357 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "Conversion.hpp"
+#include "KeyTree.hpp"
+
+using std::sort;
+
+// -- Class --------------------------------------------------------------------
+
+const KeyTree::Node KeyTree::ROOT;
+const KeyTree::Node KeyTree::NONE;
+
+/**
+ * @brief This constructor creates an empty tree.
+ *
+ * @param parent This parameter specifies the name of the parent key of all
+ *               keys stored in the tree.
+ */
+KeyTree::KeyTree(string parent) : rootName{move(parent)} {
+  Entry root;
+  root.segment = intern("");
+  root.parent = NONE;
+  nodes.push_back(root);
+}
+
+/**
+ * @brief This method returns the identifier of the given base name, adding the
+ *        base name to the tree if necessary.
+ *
+ * @param baseName This parameter stores an (unescaped) base name.
+ *
+ * @return A number that identifies `baseName`
+ */
+uint32_t KeyTree::intern(string const &baseName) {
+  auto inserted =
+      segmentIds.insert({baseName, static_cast<uint32_t>(segments.size())});
+  if (inserted.second) {
+    segments.push_back(baseName);
+  }
+  return inserted.first->second;
+}
+
+/**
+ * @brief This method returns the child of a node with the given base name,
+ *        adding the child if necessary.
+ *
+ * @param parent This parameter specifies the parent of the child.
+ * @param baseName This parameter stores the (unescaped) base name of the child.
+ *
+ * @return The child of `parent` called `baseName`
+ */
+KeyTree::Node KeyTree::child(Node const parent, string const &baseName) {
+  uint32_t segment = intern(baseName);
+  uint64_t childId = static_cast<uint64_t>(parent) << 32 | segment;
+
+  auto inserted =
+      children.insert({childId, static_cast<Node>(nodes.size())});
+  if (!inserted.second) {
+    return inserted.first->second;
+  }
+
+  Node node = inserted.first->second;
+  Entry entry;
+  entry.segment = segment;
+  entry.parent = parent;
+  nodes.push_back(entry);
+
+  if (nodes[parent].lastChild == NONE) {
+    nodes[parent].firstChild = node;
+  } else {
+    if (baseName < segments[nodes[nodes[parent].lastChild].segment]) {
+      nodes[parent].sorted = false;
+    }
+    nodes[nodes[parent].lastChild].nextSibling = node;
+  }
+  nodes[parent].lastChild = node;
+  return node;
+}
+
+/**
+ * @brief This method stores a value for a node and marks it as key.
+ *
+ * @param node This parameter specifies the node this method modifies.
+ * @param value This parameter stores the new value of `node`.
+ */
+void KeyTree::setValue(Node const node, string const &value) {
+  nodes[node].valueStart = values.size();
+  nodes[node].valueLength = value.size();
+  nodes[node].isKey = true;
+  values += value;
+}
+
+/**
+ * @brief This method marks a node as key, keeping its current value.
+ *
+ * @param node This parameter specifies the node this method modifies.
+ */
+void KeyTree::setKey(Node const node) { nodes[node].isKey = true; }
+
+/**
+ * @brief This method specifies that the children of a node form an array.
+ *
+ * @param node This parameter specifies the node this method modifies.
+ */
+void KeyTree::setArray(Node const node) { nodes[node].isArray = true; }
+
+/**
+ * @brief This method copies the subtree below a node to another node.
+ *
+ * The copied nodes share their values with the original nodes.
+ *
+ * @param source This parameter specifies the root of the copied subtree. The
+ *               subtree must not contain `target`.
+ * @param target This parameter specifies the node that receives the copy.
+ * @param keepExisting This parameter specifies if the method keeps the values
+ *                     of nodes that are already keys.
+ * @param limit This parameter specifies the maximum number of nodes this
+ *              method copies.
+ *
+ * @return The number of copied nodes. If the number is larger than `limit`,
+ *         then the method stopped before it copied the whole subtree.
+ */
+size_t KeyTree::copy(Node const source, Node const target,
+                     bool const keepExisting, size_t const limit) {
+  if (limit == 0) {
+    return 1;
+  }
+  if (nodes[source].isKey && !(keepExisting && nodes[target].isKey)) {
+    nodes[target].valueStart = nodes[source].valueStart;
+    nodes[target].valueLength = nodes[source].valueLength;
+    nodes[target].isKey = true;
+    nodes[target].isArray = nodes[source].isArray;
+  }
+
+  // `child` might grow `nodes`, so we must not keep references to entries
+  size_t copied = 1;
+  for (Node node = nodes[source].firstChild; node != NONE && copied <= limit;
+       node = nodes[node].nextSibling) {
+    copied += copy(node, child(target, segments[nodes[node].segment]),
+                   keepExisting, limit - copied);
+  }
+  return copied;
+}
+
+/**
+ * @brief This method orders the children of every node by base name.
+ *
+ * The method only sorts the children of nodes that received a child out of
+ * order, so it takes linear time for trees built from sorted data.
+ */
+void KeyTree::sortChildren() {
+  vector<Node> siblings;
+  for (Node node = ROOT; node < nodes.size(); node++) {
+    if (nodes[node].sorted) {
+      continue;
+    }
+    siblings.clear();
+    for (Node child = nodes[node].firstChild; child != NONE;
+         child = nodes[child].nextSibling) {
+      siblings.push_back(child);
+    }
+    sort(siblings.begin(), siblings.end(),
+         [this](Node const first, Node const second) {
+           return baseName(first) < baseName(second);
+         });
+
+    for (size_t index = 0; index + 1 < siblings.size(); index++) {
+      nodes[siblings[index]].nextSibling = siblings[index + 1];
+    }
+    nodes[siblings.back()].nextSibling = NONE;
+    nodes[node].firstChild = siblings.front();
+    nodes[node].lastChild = siblings.back();
+    nodes[node].sorted = true;
+  }
+}
+
+/**
+ * @brief This method returns the node for the given key name.
+ *
+ * @param name This parameter stores a key name. The name has to start with the
+ *             name of the parent key of the tree.
+ *
+ * @return The node called `name` or `NONE`, if the tree does not contain such
+ *         a node
+ */
+KeyTree::Node KeyTree::lookup(string const &name) const {
+  if (name.compare(0, rootName.size(), rootName) != 0 ||
+      (name.size() > rootName.size() && name[rootName.size()] != '/')) {
+    return NONE;
+  }
+
+  Node node = ROOT;
+  for (auto const &baseName : splitKeyName(name.substr(rootName.size()))) {
+    auto segment = segmentIds.find(baseName);
+    if (segment == segmentIds.end()) {
+      return NONE;
+    }
+    auto child =
+        children.find(static_cast<uint64_t>(node) << 32 | segment->second);
+    if (child == children.end()) {
+      return NONE;
+    }
+    node = child->second;
+  }
+  return node;
+}
+
+/**
+ * @brief This method returns the next node in depth-first order.
+ *
+ * You can visit all nodes of the tree by starting with `ROOT` and calling this
+ * method, until it returns `NONE`.
+ *
+ * @param node This parameter specifies the current node.
+ *
+ * @return The node after `node` or `NONE`, if `node` is the last node
+ */
+KeyTree::Node KeyTree::next(Node const node) const {
+  if (nodes[node].firstChild != NONE) {
+    return nodes[node].firstChild;
+  }
+  for (Node current = node; current != NONE; current = nodes[current].parent) {
+    if (nodes[current].nextSibling != NONE) {
+      return nodes[current].nextSibling;
+    }
+  }
+  return NONE;
+}
+
+/**
+ * @brief This method returns the first child of a node.
+ *
+ * @param node This parameter specifies the parent node.
+ *
+ * @return The first child of `node` or `NONE`, if `node` has no children
+ */
+KeyTree::Node KeyTree::firstChild(Node const node) const {
+  return nodes[node].firstChild;
+}
+
+/**
+ * @brief This method returns the sibling after the given node.
+ *
+ * @param node This parameter specifies the current node.
+ *
+ * @return The sibling after `node` or `NONE`, if `node` is the last child
+ */
+KeyTree::Node KeyTree::nextSibling(Node const node) const {
+  return nodes[node].nextSibling;
+}
+
+/**
+ * @brief This method returns the (unescaped) base name of a node.
+ *
+ * @param node This parameter specifies the node.
+ *
+ * @return The base name of `node`
+ */
+string const &KeyTree::baseName(Node const node) const {
+  return segments[nodes[node].segment];
+}
+
+/**
+ * @brief This method returns the full name of a node.
+ *
+ * @param node This parameter specifies the node.
+ *
+ * @return The (escaped) key name of `node`
+ */
+string KeyTree::name(Node const node) const {
+  vector<Node> path;
+  for (Node current = node; current != ROOT; current = nodes[current].parent) {
+    path.push_back(current);
+  }
+
+  CppKey key{rootName, KEY_END};
+  for (auto part = path.rbegin(); part != path.rend(); part++) {
+    key.addBaseName(baseName(*part));
+  }
+  return key.getName();
+}
+
+/**
+ * @brief This method returns the value of a node.
+ *
+ * @param node This parameter specifies the node.
+ *
+ * @return The value of `node`
+ */
+string KeyTree::value(Node const node) const {
+  return values.substr(nodes[node].valueStart, nodes[node].valueLength);
+}
+
+/**
+ * @brief This method checks if a node represents a key.
+ *
+ * Nodes that only exist as part of the name of other keys are not keys
+ * themselves.
+ *
+ * @param node This parameter specifies the node.
+ *
+ * @retval true If `node` represents a key
+ *         false Otherwise
+ */
+bool KeyTree::isKey(Node const node) const { return nodes[node].isKey; }
+
+/**
+ * @brief This method returns the number of nodes stored in the tree.
+ *
+ * @return The number of nodes, including the root node
+ */
+size_t KeyTree::size() const { return nodes.size(); }
+
+/**
+ * @brief This method converts a subtree to a key set.
+ *
+ * @param node This parameter specifies the root of the converted subtree.
+ *
+ * @return A key set containing all keys at and below `node`
+ */
+CppKeySet KeyTree::keySet(Node const node) const {
+  CppKeySet keys;
+  addKeys(node, CppKey{name(node), KEY_END}, keys);
+  return keys;
+}
+
+/**
+ * @brief This method adds the keys of the given subtree to a key set.
+ *
+ * @param node This parameter specifies the root of the subtree.
+ * @param key This key stores the name of `node`.
+ * @param keys This parameter stores the key set this method modifies.
+ */
+void KeyTree::addKeys(Node const node, CppKey const &key,
+                      CppKeySet &keys) const {
+  Entry const &entry = nodes[node];
+  if (entry.isKey) {
+    CppKey copy{key.getName(), KEY_END};
+    if (entry.valueLength > 0) {
+      copy.setString(value(node));
+    }
+    if (entry.isArray) {
+      copy.setMeta("array",
+                   entry.lastChild == NONE ? "" : baseName(entry.lastChild));
+    }
+    keys.append(copy);
+  }
+
+  for (Node child = entry.firstChild; child != NONE;
+       child = nodes[child].nextSibling) {
+    CppKey childKey{key.getName(), KEY_END};
+    childKey.addBaseName(baseName(child));
+    addKeys(child, childKey, keys);
+  }
+}
@@ -0,0 +1,273 @@
+#ifndef YANLR_KEY_TREE_HPP
+#define YANLR_KEY_TREE_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <kdb.hpp>
+
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class stores keys in a compact tree structure.
+ *
+ * Unlike a key set, the tree does not store the full name of each key. Every
+ * node only stores a reference to its (interned) base name and to its parent.
+ * All values are part of a single string. The tree is therefore much smaller
+ * than a key set, if many keys share long prefixes.
+ *
+ * The children of a node keep the order in which they were added, until
+ * `sortChildren` orders them by base name.
+ */
+class KeyTree {
+public:
+  /** This type identifies a node of the tree. */
+  using Node = uint32_t;
+
+  /** This node represents the parent key of all keys stored in the tree. */
+  static const Node ROOT = 0;
+
+  /** This value represents a node that does not exist. */
+  static const Node NONE = UINT32_MAX;
+
+private:
+  /** This structure stores the data of a single node. */
+  struct Entry {
+    /** This number identifies the base name of the node in `segments`. */
+    uint32_t segment;
+    /** This variable stores the parent of the node. */
+    Node parent;
+    /** This variable stores the first child of the node. */
+    Node firstChild = NONE;
+    /** This variable stores the last child of the node. */
+    Node lastChild = NONE;
+    /** This variable stores the next sibling of the node. */
+    Node nextSibling = NONE;
+    /** This number stores the start of the value of the node in `values`. */
+    size_t valueStart = 0;
+    /** This number stores the length of the value of the node. */
+    size_t valueLength = 0;
+    /** This boolean specifies if the node represents a key. */
+    bool isKey = false;
+    /** This boolean specifies if the children of the node form an array. */
+    bool isArray = false;
+    /** This boolean specifies if the children are ordered by base name. */
+    bool sorted = true;
+  };
+
+  /** This variable stores the name of the parent key of the tree. */
+  string rootName;
+
+  /** This vector stores all nodes of the tree. */
+  vector<Entry> nodes;
+
+  /** This map stores the identifier of each base name in the tree. */
+  unordered_map<string, uint32_t> segmentIds;
+
+  /** This vector stores each base name at the position of its identifier. */
+  vector<string> segments;
+
+  /** This map stores the child of a node for a base name identifier. */
+  unordered_map<uint64_t, Node> children;
+
+  /** This string stores the values of all nodes. */
+  string values;
+
+  /**
+   * @brief This method returns the identifier of the given base name, adding
+   *        the base name to the tree if necessary.
+   *
+   * @param baseName This parameter stores an (unescaped) base name.
+   *
+   * @return A number that identifies `baseName`
+   */
+  uint32_t intern(string const &baseName);
+
+  /**
+   * @brief This method adds the keys of the given subtree to a key set.
+   *
+   * @param node This parameter specifies the root of the subtree.
+   * @param key This key stores the name of `node`.
+   * @param keys This parameter stores the key set this method modifies.
+   */
+  void addKeys(Node const node, CppKey const &key, CppKeySet &keys) const;
+
+public:
+  /**
+   * @brief This constructor creates an empty tree.
+   *
+   * @param parent This parameter specifies the name of the parent key of all
+   *               keys stored in the tree.
+   */
+  KeyTree(string parent);
+
+  /**
+   * @brief This method returns the child of a node with the given base name,
+   *        adding the child if necessary.
+   *
+   * @param parent This parameter specifies the parent of the child.
+   * @param baseName This parameter stores the (unescaped) base name of the
+   *                 child.
+   *
+   * @return The child of `parent` called `baseName`
+   */
+  Node child(Node const parent, string const &baseName);
+
+  /**
+   * @brief This method stores a value for a node and marks it as key.
+   *
+   * @param node This parameter specifies the node this method modifies.
+   * @param value This parameter stores the new value of `node`.
+   */
+  void setValue(Node const node, string const &value);
+
+  /**
+   * @brief This method marks a node as key, keeping its current value.
+   *
+   * @param node This parameter specifies the node this method modifies.
+   */
+  void setKey(Node const node);
+
+  /**
+   * @brief This method specifies that the children of a node form an array.
+   *
+   * @param node This parameter specifies the node this method modifies.
+   */
+  void setArray(Node const node);
+
+  /**
+   * @brief This method copies the subtree below a node to another node.
+   *
+   * The copied nodes share their values with the original nodes.
+   *
+   * @param source This parameter specifies the root of the copied subtree.
+   *               The subtree must not contain `target`.
+   * @param target This parameter specifies the node that receives the copy.
+   * @param keepExisting This parameter specifies if the method keeps the
+   *                     values of nodes that are already keys.
+   * @param limit This parameter specifies the maximum number of nodes this
+   *              method copies.
+   *
+   * @return The number of copied nodes. If the number is larger than `limit`,
+   *         then the method stopped before it copied the whole subtree.
+   */
+  size_t copy(Node const source, Node const target, bool const keepExisting,
+              size_t const limit);
+
+  /**
+   * @brief This method orders the children of every node by base name.
+   *
+   * The method only sorts the children of nodes that received a child out of
+   * order, so it takes linear time for trees built from sorted data.
+   */
+  void sortChildren();
+
+  /**
+   * @brief This method returns the node for the given key name.
+   *
+   * @param name This parameter stores a key name. The name has to start with
+   *             the name of the parent key of the tree.
+   *
+   * @return The node called `name` or `NONE`, if the tree does not contain
+   *         such a node
+   */
+  Node lookup(string const &name) const;
+
+  /**
+   * @brief This method returns the next node in depth-first order.
+   *
+   * You can visit all nodes of the tree by starting with `ROOT` and calling
+   * this method, until it returns `NONE`.
+   *
+   * @param node This parameter specifies the current node.
+   *
+   * @return The node after `node` or `NONE`, if `node` is the last node
+   */
+  Node next(Node const node) const;
+
+  /**
+   * @brief This method returns the first child of a node.
+   *
+   * @param node This parameter specifies the parent node.
+   *
+   * @return The first child of `node` or `NONE`, if `node` has no children
+   */
+  Node firstChild(Node const node) const;
+
+  /**
+   * @brief This method returns the sibling after the given node.
+   *
+   * @param node This parameter specifies the current node.
+   *
+   * @return The sibling after `node` or `NONE`, if `node` is the last child
+   */
+  Node nextSibling(Node const node) const;
+
+  /**
+   * @brief This method returns the (unescaped) base name of a node.
+   *
+   * @param node This parameter specifies the node.
+   *
+   * @return The base name of `node`
+   */
+  string const &baseName(Node const node) const;
+
+  /**
+   * @brief This method returns the full name of a node.
+   *
+   * @param node This parameter specifies the node.
+   *
+   * @return The (escaped) key name of `node`
+   */
+  string name(Node const node) const;
+
+  /**
+   * @brief This method returns the value of a node.
+   *
+   * @param node This parameter specifies the node.
+   *
+   * @return The value of `node`
+   */
+  string value(Node const node) const;
+
+  /**
+   * @brief This method checks if a node represents a key.
+   *
+   * Nodes that only exist as part of the name of other keys are not keys
+   * themselves.
+   *
+   * @param node This parameter specifies the node.
+   *
+   * @retval true If `node` represents a key
+   *         false Otherwise
+   */
+  bool isKey(Node const node) const;
+
+  /**
+   * @brief This method returns the number of nodes stored in the tree.
+   *
+   * @return The number of nodes, including the root node
+   */
+  size_t size() const;
+
+  /**
+   * @brief This method converts a subtree to a key set.
+   *
+   * @param node This parameter specifies the root of the converted subtree.
+   *
+   * @return A key set containing all keys at and below `node`
+   */
+  CppKeySet keySet(Node const node = ROOT) const;
+};
+
+#endif // YANLR_KEY_TREE_HPP
@@ -0,0 +1,883 @@
+/*
+ * This lexer uses the same idea as the scanner of `libyaml` (and various other
+ * YAML libs) to detect simple keys (keys with no `?` prefix).
+ *
+ * For a detailed explanation of the algorithm, I recommend to take a look at
+ * the scanner of
+ *
+ * - SnakeYAML Engine:
+ *   https://bitbucket.org/asomov/snakeyaml-engine
+ * - or LLVM’s YAML library:
+ *   https://github.com/llvm-mirror/llvm/blob/master/lib/Support/YAMLParser.cpp
+ *
+ * .
+ */
+
+// -- Imports ------------------------------------------------------------------
+
+#include "Conversion.hpp"
+#include "YAMLLexer.hpp"
+
+using std::make_pair;
+using std::make_shared;
+using std::to_string;
+
+using antlr4::ParseCancellationException;
+
+using spdlog::get;
+using spdlog::stderr_color_mt;
+
+// -- Types --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates the default settings and looks up the
+ *        logger of the lexer.
+ */
+LexerSettings::LexerSettings() {
+  // All lexers share a single logger. The application decides which messages
+  // the logger prints (`spdlog::set_level`).
+  console = get("console");
+  if (!console) {
+    console = stderr_color_mt("console");
+  }
+  LOG("Init lexer");
+}
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a lexer core without input.
+ *
+ * @param owner This parameter stores the token source that emits the tokens
+ *              of this core.
+ * @param configuration This parameter stores the settings of the lexer, which
+ *                      have to outlive the core.
+ */
+template <typename Input>
+LexerCore<Input>::LexerCore(TokenSource *owner,
+                            LexerSettings const &configuration)
+    : settings(configuration), console{configuration.console.get()},
+      source{owner, nullptr} {}
+
+/**
+ * @brief This method resets the state of the lexer, so it can scan a new
+ *        input.
+ *
+ * @param stream This character stream stores the data this lexer scans.
+ * @param scanned This parameter stores the input policy for `stream`.
+ */
+template <typename Input>
+void LexerCore<Input>::reset(CharStream *stream, Input scanned) {
+  LOG("Reset lexer");
+
+  input = scanned;
+  source.second = stream;
+
+  tokens.clear();
+  lines = make_shared<LineIndex>(stream);
+  lineStart = 0;
+  lineContainsData = false;
+  tokensEmitted = 0;
+  fetchesSinceCheck = 0;
+  indents = stack<size_t>{deque<size_t>{0}};
+  done = false;
+  simpleKey.first.reset();
+  simpleKey.second = 0;
+  if (settings.selection) {
+    settings.selection->reset();
+  }
+
+  scanStart();
+}
+
+/**
+ * @brief This function checks if the lexer needs to scan additional tokens.
+ *
+ * @retval true If the lexer should fetch additional tokens
+ *         false Otherwise
+ */
+template <typename Input>
+bool LexerCore<Input>::needMoreTokens() const {
+  if (done) {
+    return false;
+  }
+
+  // We can emit all tokens in front of a simple key candidate. If the
+  // candidate is located at the start of the queue, then we need to keep it,
+  // until we know if the lexer has to insert a `KEY` token there.
+  bool keyCandidateAtFront =
+      simpleKey.first != nullptr && simpleKey.second == tokensEmitted;
+  return keyCandidateAtFront || tokens.empty();
+}
+
+/**
+ * @brief This method removes the simple key candidate, if it can not start a
+ *        simple key anymore.
+ *
+ * A simple key has to be located on a single line and it must not be longer
+ * than 1024 characters. If the lexer moved past these limits, then the
+ * candidate is stale.
+ */
+template <typename Input>
+void LexerCore<Input>::removeStaleSimpleKey() {
+  if (simpleKey.first == nullptr) {
+    return;
+  }
+
+  // We only count the characters of long candidates, since every character
+  // takes at least one byte
+  size_t const start = simpleKey.first->getStartIndex();
+  size_t const end = input.index();
+  if (start < lineStart || (end - start > MAXIMUM_SIMPLE_KEY_LENGTH &&
+                            lines->characters(start, end) >
+                                MAXIMUM_SIMPLE_KEY_LENGTH)) {
+    LOG("Remove stale simple key candidate");
+    simpleKey.first.reset();
+  }
+}
+
+/**
+ * @brief This method retrieves the current (not already emitted) token
+ *        produced by the lexer.
+ *
+ * @return A token of the token stream produced by the lexer
+ */
+template <typename Input>
+unique_ptr<Token> LexerCore<Input>::nextToken() {
+  LOG("Retrieve next token");
+  while (needMoreTokens()) {
+    fetchTokens();
+    // Both checks only compare numbers, as long as the lexer does not read
+    // the clock
+    if (tokens.size() > settings.limits.queue) {
+      throw ParseCancellationException(
+          position() + " Token queue exceeds the limit of " +
+          to_string(settings.limits.queue) + " tokens");
+    }
+    if (++fetchesSinceCheck >= 256) {
+      fetchesSinceCheck = 0;
+      if (std::chrono::steady_clock::now() > settings.limits.deadline) {
+        throw ParseCancellationException(position() +
+                                         " Parsing exceeded the deadline");
+      }
+    }
+    LOG("Tokens:");
+    for (unique_ptr<CommonToken> const &token : tokens) {
+      LOGF("\t {}", token->toString());
+    }
+  }
+
+  // If `fetchTokens` was unable to retrieve a token (error condition), we emit
+  // `EOF`.
+  if (tokens.size() <= 0) {
+    tokens.push_back(
+        commonToken(Token::EOF, input.index(), input.index(), "EOF"));
+  }
+  unique_ptr<CommonToken> token = move(tokens.front());
+  tokens.pop_front();
+  tokensEmitted++;
+  LOGF("Emit token {}", token->toString());
+  // Moving the stream after every token would cost a virtual call per token,
+  // and no caller reads the position of the stream while the lexer runs
+  if (token->getType() == Token::EOF) {
+    input.sync();
+  }
+  return token;
+}
+
+/**
+ * @brief This method retrieves the current line index.
+ *
+ * @return The index of the line the lexer is currently scanning
+ */
+template <typename Input> size_t LexerCore<Input>::getLine() const {
+  return lines->line(input.index());
+}
+
+/**
+ * @brief This method returns the position in the current line.
+ *
+ * @return The character index in the line the lexer is scanning
+ */
+template <typename Input>
+size_t LexerCore<Input>::getCharPositionInLine() const {
+  return lines->column(input.index());
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This function creates a new token with the specified parameters.
+ *
+ * @param type This parameter specifies the type of the token this function
+ *             should create.
+ * @param start This number specifies the start index of the returned token
+ *              inside the character stream `input`.
+ * @param stop This number specifies the stop index of the returned token
+ *             inside the character stream `input`.
+ *
+ * @return A token with the specified parameters
+ */
+template <typename Input>
+unique_ptr<CommonToken> LexerCore<Input>::commonToken(size_t type,
+                                                      size_t start,
+                                                      size_t stop) {
+  return commonToken(type, start, stop, "");
+}
+
+/**
+ * @brief This function creates a new token with the specified parameters.
+ *
+ * @param type This parameter specifies the type of the token this function
+ *             should create.
+ * @param start This number specifies the start index of the returned token
+ *              inside the character stream `input`.
+ * @param stop This number specifies the stop index of the returned token
+ *             inside the character stream `input`.
+ * @param text This string specifies the text of the returned token.
+ *
+ * @return A token with the specified parameters
+ */
+template <typename Input>
+unique_ptr<CommonToken> LexerCore<Input>::commonToken(size_t type,
+                                                      size_t start,
+                                                      size_t stop,
+                                                      string text) {
+  if (settings.positionFactory) {
+    return settings.positionFactory->create(lines, source, type, text, start,
+                                            stop);
+  }
+  // Other factories need the position of the token right away
+  return settings.factory->create(source, type, text, Token::DEFAULT_CHANNEL,
+                                  start, stop, lines->line(start),
+                                  lines->column(start));
+}
+
+/**
+ * @brief This method returns the current position of the lexer in the format
+ *        of error messages.
+ *
+ * @return The current line and character position of the lexer
+ */
+template <typename Input>
+string LexerCore<Input>::position() const {
+  return to_string(getLine()) + ":" + to_string(getCharPositionInLine());
+}
+
+/**
+ * @brief This method checks if the current scalar exceeds the size limit.
+ *
+ * @param start This number specifies the start index of the scalar.
+ *
+ * @throws ParseCancellationException If the scalar is too large
+ */
+template <typename Input>
+void LexerCore<Input>::checkScalarSize(size_t const start) const {
+  if (input.index() - start > settings.limits.scalarBytes) {
+    throw ParseCancellationException(
+        position() + " Scalar exceeds the limit of " +
+        to_string(settings.limits.scalarBytes) + " bytes");
+  }
+}
+
+/**
+ * @brief This function adds an indentation value if the given value is smaller
+ *        than the current indentation.
+ *
+ * @param lineIndex This parameter specifies the indentation value that this
+ *                  function compares to the current indentation.
+ *
+ * @retval true If the function added an indentation value
+ *         false Otherwise
+ */
+template <typename Input>
+bool LexerCore<Input>::addIndentation(size_t const lineIndex) {
+  if (lineIndex > indents.top()) {
+    // The stack also contains the indentation of the top level
+    if (indents.size() > settings.limits.depth) {
+      throw ParseCancellationException(
+          position() + " Nesting depth exceeds the limit of " +
+          to_string(settings.limits.depth));
+    }
+    LOGF("Add indentation {}", lineIndex);
+    indents.push(lineIndex);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief This method adds new tokens to the token stream.
+ */
+template <typename Input>
+void LexerCore<Input>::fetchTokens() {
+  scanToNextToken();
+  removeStaleSimpleKey();
+
+  // The first character picks the scanner. Only value indicators and element
+  // indicators need a second character, which has to be blank.
+  Scanner scanner = scannerFor(input.LA(1));
+  if ((scanner == Scanner::VALUE || scanner == Scanner::ELEMENT) &&
+      !isClass(input.LA(2), CharacterClass::BLANK)) {
+    scanner = Scanner::PLAIN;
+  }
+
+  // Comments do not affect the indentation
+  if (scanner == Scanner::COMMENT) {
+    scanComment();
+    return;
+  }
+
+  addBlockEnd(column());
+  lineContainsData = true;
+
+  if (settings.selection && scanner != Scanner::END) {
+    settings.selection->leave(column(), scanner == Scanner::ELEMENT);
+    if (settings.selection->done()) {
+      LOG("Found all requested keys");
+      scanEnd();
+      return;
+    }
+  }
+
+  switch (scanner) {
+  case Scanner::END:
+    scanEnd();
+    break;
+  case Scanner::VALUE:
+    scanValue();
+    break;
+  case Scanner::ELEMENT:
+    scanElement();
+    break;
+  case Scanner::DOUBLE_QUOTED:
+    scanDoubleQuotedScalar();
+    break;
+  case Scanner::SINGLE_QUOTED:
+    scanSingleQuotedScalar();
+    break;
+  case Scanner::ANCHOR:
+    scanNodeReference(YAMLLexer::ANCHOR);
+    break;
+  case Scanner::ALIAS:
+    scanNodeReference(YAMLLexer::ALIAS);
+    break;
+  default:
+    scanPlainScalar();
+  }
+}
+
+/**
+ * @brief This method returns the current column of the lexer.
+ *
+ * @return The position (starting with 1) of the lexer inside the current
+ *         line in number of bytes
+ */
+template <typename Input> size_t LexerCore<Input>::column() const {
+  return input.index() - lineStart + 1;
+}
+
+/**
+ * @brief This method consumes characters from the input stream.
+ *
+ * The consumed characters must not contain a line break. Use
+ * `forwardCharacter` for characters that might be a line break.
+ *
+ * @param characters This parameter specifies the number of characters the
+ *                   the function should consume.
+ */
+template <typename Input>
+void LexerCore<Input>::forward(size_t const characters) {
+  LOGF("Forward {} characters", characters);
+
+  for (size_t charsLeft = characters; charsLeft > 0; charsLeft--) {
+    if (input.LA(1) == Token::EOF) {
+      LOG("Hit EOF!");
+      return;
+    }
+    input.consume();
+  }
+}
+
+/**
+ * @brief This method consumes a single character, which might be a line
+ *        break, from the input stream.
+ */
+template <typename Input>
+void LexerCore<Input>::forwardCharacter() {
+  bool const lineBreak = input.LA(1) == '\n';
+  forward();
+  if (lineBreak) {
+    lineContainsData = false;
+    lineStart = input.index();
+    lines->addLine(lineStart);
+  }
+}
+
+/**
+ * @brief This method removes uninteresting characters from the input.
+ */
+template <typename Input>
+void LexerCore<Input>::scanToNextToken() {
+  LOG("Scan to next token");
+  uint8_t characterClass;
+  while ((characterClass = ::characterClass(input.LA(1))) &
+         CharacterClass::BLANK) {
+    if (characterClass & CharacterClass::SPACE) {
+      forward();
+    } else {
+      forwardCharacter();
+      LOG("Skipped newline");
+    }
+  }
+  LOG("Found next token");
+}
+
+/**
+ * @brief This method checks if the input at the specified offset starts a key
+ *        value token.
+ *
+ * @param offset This parameter specifies an offset to the current position,
+ *               where this function will look for a key value token.
+ *
+ * @retval true If the input matches a key value token
+ *         false Otherwise
+ */
+template <typename Input>
+bool LexerCore<Input>::isValue(size_t const offset) const {
+  return input.LA(offset) == ':' &&
+         isClass(input.LA(offset + 1), CharacterClass::BLANK);
+}
+
+/**
+ * @brief This method checks if the current input starts a list element.
+ *
+ * @retval true If the input matches a list element token
+ *         false Otherwise
+ */
+template <typename Input>
+bool LexerCore<Input>::isElement() const {
+  return input.LA(1) == '-' && isClass(input.LA(2), CharacterClass::BLANK);
+}
+
+/**
+ * @brief This method checks if the input at the specified offset starts a line
+ *        comment.
+ *
+ * @param offset This parameter specifies an offset to the current position,
+ *               where this function will look for a comment token.
+ *
+ * @retval true If the input matches a comment token
+ *         false Otherwise
+ */
+template <typename Input>
+bool LexerCore<Input>::isComment(size_t const offset) const {
+  return input.LA(offset) == '#' &&
+         isClass(input.LA(offset + 1), CharacterClass::BLANK);
+}
+
+/**
+ * @brief This method saves a token for a simple key candidate located at the
+ *        current input position.
+ */
+template <typename Input>
+void LexerCore<Input>::addSimpleKeyCandidate() {
+  size_t position = tokens.size() + tokensEmitted;
+  size_t index = input.index();
+  simpleKey =
+      make_pair(commonToken(YAMLLexer::KEY, index, index, "KEY"), position);
+}
+
+/**
+ * @brief This method adds block closing tokens to the token queue, if the
+ *        indentation decreased.
+ *
+ * @param lineIndex This parameter specifies the column (indentation in number
+ *                  of spaces) for which this method should add block end
+ *                  tokens.
+ */
+template <typename Input>
+void LexerCore<Input>::addBlockEnd(size_t const lineIndex) {
+  while (lineIndex < indents.top()) {
+    LOG("Add block end");
+    size_t index = input.index();
+    tokens.push_back(
+        commonToken(YAMLLexer::BLOCK_END, index, index, "BLOCK END"));
+    indents.pop();
+  }
+}
+
+/**
+ * @brief This method consumes the remainder of the current line without
+ *        creating tokens.
+ *
+ * Quoted scalars that start on the current line might continue on the
+ * following lines. The method consumes the whole scalar in this case.
+ */
+template <typename Input>
+void LexerCore<Input>::skipLine() {
+  while (true) {
+    while (input.LA(1) == ' ') {
+      forward();
+    }
+
+    if (input.LA(1) == Token::EOF) {
+      return;
+    } else if (input.LA(1) == '\n') {
+      forwardCharacter();
+      return;
+    } else if (isElement()) {
+      forward();
+    } else if (input.LA(1) == '#') {
+      while (input.LA(1) != '\n' && input.LA(1) != Token::EOF) {
+        forward();
+      }
+    } else if (input.LA(1) == '"') {
+      forward();
+      while (input.LA(1) != '"' && input.LA(1) != Token::EOF) {
+        if (input.LA(1) == '\\' && input.LA(2) != Token::EOF) {
+          forward(); // Escape sequences might contain a double quote
+        }
+        forwardCharacter();
+      }
+      forward();
+    } else if (input.LA(1) == '\'') {
+      forward();
+      while ((input.LA(1) != '\'' || input.LA(2) == '\'') &&
+             input.LA(1) != Token::EOF) {
+        if (input.LA(1) == '\'') {
+          forward(2);
+        } else {
+          forwardCharacter();
+        }
+      }
+      forward();
+    } else {
+      // Plain scalars end at the line end, a value indicator or a comment
+      while (input.LA(1) != '\n' && input.LA(1) != Token::EOF &&
+             !isValue() && !(input.LA(1) == ' ' && isComment(2))) {
+        forward();
+      }
+      if (isValue()) {
+        forward();
+      }
+    }
+  }
+}
+
+/**
+ * @brief This method consumes the remainder of the current block collection
+ *        entry without creating tokens.
+ *
+ * @param entryColumn This number specifies the column of the key or element
+ *                    that starts the skipped entry. The method stops at the
+ *                    first line (containing data) that is not indented further
+ *                    than this column.
+ */
+template <typename Input>
+void LexerCore<Input>::skipBlock(size_t const entryColumn) {
+  LOGF("Skip entry at column {}", entryColumn);
+  skipLine();
+  while (input.LA(1) != Token::EOF) {
+    size_t lookahead = 1;
+    while (input.LA(lookahead) == ' ') {
+      lookahead++;
+    }
+    size_t const character = input.LA(lookahead);
+    bool const empty = character == '\n' || character == '#';
+    if (character == Token::EOF || (!empty && lookahead <= entryColumn)) {
+      return;
+    }
+    forward(lookahead - 1);
+    skipLine();
+  }
+}
+
+/**
+ * @brief This method adds the token for the start of the YAML stream to
+ *        `tokens`.
+ */
+template <typename Input>
+void LexerCore<Input>::scanStart() {
+  LOG("Scan start");
+  auto start = commonToken(YAMLLexer::STREAM_START, input.index(),
+                           input.index(), "START");
+  tokens.push_back(move(start));
+}
+
+/**
+ * @brief This method adds the end markers to the token queue.
+ */
+template <typename Input>
+void LexerCore<Input>::scanEnd() {
+  addBlockEnd(0);
+  tokens.push_back(
+      commonToken(YAMLLexer::STREAM_END, input.index(), input.index(), "END"));
+  tokens.push_back(
+      commonToken(Token::EOF, input.index(), input.index(), "EOF"));
+  done = true;
+}
+
+/**
+ * @brief This method scans a single quoted scalar and adds it to the token
+ *        queue.
+ */
+template <typename Input>
+void LexerCore<Input>::scanSingleQuotedScalar() {
+  LOG("Scan single quoted scalar");
+
+  size_t start = input.index();
+  ssize_t marker = input.mark();
+  // A single quoted scalar can start a simple key
+  addSimpleKeyCandidate();
+
+  forward(); // Include initial single quote
+  while (input.LA(1) != '\'' || input.LA(2) == '\'') {
+    if (input.LA(1) == Token::EOF) {
+      throw ParseCancellationException(
+          "Unable to find closing quote of single quoted scalar");
+    }
+    if (input.LA(1) == '\'') {
+      forward(2); // Escaped single quote
+    } else {
+      forwardCharacter();
+    }
+    checkScalarSize(start);
+  }
+  forward(); // Include closing single quote
+  lineContainsData = true;
+  tokens.push_back(
+      commonToken(YAMLLexer::SINGLE_QUOTED_SCALAR, start, input.index() - 1));
+  input.release(marker);
+}
+
+/**
+ * @brief This method scans a double quoted scalar and adds it to the token
+ *        queue.
+ */
+template <typename Input>
+void LexerCore<Input>::scanDoubleQuotedScalar() {
+  LOG("Scan double quoted scalar");
+  size_t start = input.index();
+  ssize_t marker = input.mark();
+
+  // A double quoted scalar can start a simple key
+  addSimpleKeyCandidate();
+
+  forward(); // Include initial double quote
+  while (input.LA(1) != '"') {
+    if (input.LA(1) == Token::EOF) {
+      throw ParseCancellationException(
+          "Unable to find closing quote of double quoted scalar");
+    }
+    if (input.LA(1) == '\\' && input.LA(2) != Token::EOF) {
+      forward(); // Escape sequences might contain a double quote
+    }
+    forwardCharacter();
+    checkScalarSize(start);
+  }
+  forward(); // Include closing double quote
+  lineContainsData = true;
+  tokens.push_back(
+      commonToken(YAMLLexer::DOUBLE_QUOTED_SCALAR, start, input.index() - 1));
+  input.release(marker);
+}
+
+/**
+ * @brief This method scans an anchor (`&name`) or an alias (`*name`) and adds
+ *        it to the token queue.
+ *
+ * @param type This parameter specifies the type of the token this method adds
+ *             (`ANCHOR` or `ALIAS`).
+ */
+template <typename Input>
+void LexerCore<Input>::scanNodeReference(size_t const type) {
+  LOG(type == YAMLLexer::ANCHOR ? "Scan anchor" : "Scan alias");
+  size_t start = input.index();
+  ssize_t marker = input.mark();
+
+  forward(); // Include indicator (`&` or `*`)
+  // We only support block collections, so the name ends at the next space
+  while (!isClass(input.LA(1), CharacterClass::BLANK | CharacterClass::END)) {
+    forward();
+  }
+  if (input.index() - start <= 1) {
+    throw ParseCancellationException(
+        string{type == YAMLLexer::ANCHOR ? "Anchor" : "Alias"} +
+        " without name");
+  }
+  tokens.push_back(commonToken(type, start, input.index() - 1));
+  input.release(marker);
+}
+
+/**
+ * @brief This method scans a plain scalar and adds it to the token queue.
+ */
+template <typename Input>
+void LexerCore<Input>::scanPlainScalar() {
+  LOG("Scan plain scalar");
+  size_t start = input.index();
+  ssize_t marker = input.mark();
+  // A plain scalar can start a simple key
+  addSimpleKeyCandidate();
+
+  size_t lengthSpace = 0;
+  size_t lengthNonSpace = 0;
+  while (true) {
+    lengthNonSpace = countPlainNonSpace(lengthSpace);
+    if (lengthNonSpace == 0) {
+      break;
+    }
+    forward(lengthSpace + lengthNonSpace);
+    checkScalarSize(start);
+    lengthSpace = countPlainSpace();
+  }
+
+  tokens.push_back(
+      commonToken(YAMLLexer::PLAIN_SCALAR, start, input.index() - 1));
+  input.release(marker);
+}
+
+/**
+ * @brief This method counts the number of non space characters that can be part
+ *        of a plain scalar at position `offset`.
+ *
+ * @param offset This parameter specifies an offset to the current input
+ *               position, where this function searches for non space
+ *               characters.
+ *
+ * @return The number of non-space characters at the input position `offset`
+ */
+template <typename Input>
+size_t LexerCore<Input>::countPlainNonSpace(size_t const offset) const {
+  LOG("Scan non space characters");
+  size_t lookahead = offset + 1;
+  while (true) {
+    uint8_t const characterClass = ::characterClass(input.LA(lookahead));
+    // `:` and `#` only end the scalar, if a blank character follows
+    if ((characterClass & (CharacterClass::BLANK | CharacterClass::END)) ||
+        ((characterClass & CharacterClass::INDICATOR) &&
+         isClass(input.LA(lookahead + 1), CharacterClass::BLANK))) {
+      break;
+    }
+    lookahead++;
+  }
+
+  LOGF("Found {} non-space characters", lookahead - offset - 1);
+  return lookahead - offset - 1;
+}
+
+/**
+ * @brief This method counts the number of space characters that can be part
+ *        of a plain scalar at the current input position.
+ *
+ * @return The number of space characters at the current input position
+ */
+template <typename Input>
+size_t LexerCore<Input>::countPlainSpace() const {
+  LOG("Scan spaces");
+  size_t lookahead = 1;
+  while (isClass(input.LA(lookahead), CharacterClass::SPACE)) {
+    lookahead++;
+  }
+  LOGF("Found {} space characters", lookahead - 1);
+  return lookahead - 1;
+}
+
+/**
+ * @brief This method scans a comment and adds it to the token queue, unless
+ *        the lexer drops comments.
+ */
+template <typename Input>
+void LexerCore<Input>::scanComment() {
+  LOG("Scan comment");
+  if (settings.commentMode == CommentMode::DROP) {
+    // A comment never contains a line break, so we can jump to the line end
+    input.skipToLineEnd();
+    return;
+  }
+
+  size_t start = input.index();
+  ssize_t marker = input.mark();
+
+  while (input.LA(1) != '\n' && input.LA(1) != Token::EOF) {
+    forward();
+  }
+  auto comment = commonToken(YAMLLexer::COMMENT, start, input.index() - 1);
+  comment->setChannel(settings.commentMode == CommentMode::PRESERVE &&
+                              lineContainsData
+                          ? YAMLLexer::TRAILING_COMMENT_CHANNEL
+                          : Token::HIDDEN_CHANNEL);
+  tokens.push_back(move(comment));
+  input.release(marker);
+}
+
+/**
+ * @brief This method scans a mapping value token and adds it to the token
+ *        queue.
+ */
+template <typename Input>
+void LexerCore<Input>::scanValue() {
+  LOG("Scan value");
+  tokens.push_back(
+      commonToken(YAMLLexer::VALUE, input.index(), input.index() + 1));
+  size_t const keyLineStart = lineStart;
+  forward();
+  forwardCharacter();
+  if (simpleKey.first == nullptr) {
+    throw ParseCancellationException("Unable to locate key for value");
+  }
+  size_t const keyIndex = simpleKey.first->getStartIndex();
+  size_t const start = keyIndex - keyLineStart + 1;
+  auto keyPosition = tokens.begin() + simpleKey.second - tokensEmitted;
+  keyPosition = tokens.insert(keyPosition, move(simpleKey.first));
+  // We only need the text of the key for a selective parse
+  bool relevant = true;
+  if (settings.selection) {
+    // The scalar that stores the key follows directly after the `KEY` token
+    string const key = scalarToText((*(keyPosition + 1))->getText());
+    relevant = settings.selection->enterKey(start, key);
+  }
+  if (addIndentation(start)) {
+    tokens.insert(keyPosition, commonToken(YAMLLexer::MAPPING_START, keyIndex,
+                                           keyIndex, "MAPPING START"));
+  }
+
+  if (!relevant) {
+    skipBlock(start);
+  }
+}
+
+/**
+ * @brief This method scans a list element token and adds it to the token
+ *        queue.
+ */
+template <typename Input>
+void LexerCore<Input>::scanElement() {
+  LOG("Scan element");
+  size_t const start = column();
+  if (addIndentation(start)) {
+    tokens.push_back(commonToken(YAMLLexer::SEQUENCE_START, input.index(),
+                                 input.index(), "SEQUENCE START"));
+  }
+  tokens.push_back(
+      commonToken(YAMLLexer::ELEMENT, input.index(), input.index() + 1));
+  forward();
+  forwardCharacter();
+
+  if (settings.selection && !settings.selection->enterElement(start)) {
+    skipBlock(start);
+    // The grammar requires a child for every element. An empty scalar keeps
+    // the array indices of the following elements intact.
+    tokens.push_back(
+        commonToken(YAMLLexer::PLAIN_SCALAR, input.index(),
+                    input.index() - 1, ""));
+  }
+}
+
+// -- Instantiations -----------------------------------------------------------
+
+template class LexerCore<BufferInput>;
+template class LexerCore<StreamInput>;
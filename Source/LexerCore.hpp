@@ -0,0 +1,510 @@
+/*
+ * This lexer uses the same idea as the scanner of `libyaml` (and various other
+ * YAML libs) to detect simple keys (keys with no `?` prefix).
+ *
+ * For a detailed explanation of the algorithm, I recommend to take a look at
+ * the scanner of
+ *
+ * - SnakeYAML Engine:
+ *   https://bitbucket.org/asomov/snakeyaml-engine
+ * - or LLVM’s YAML library:
+ *   https://github.com/llvm-mirror/llvm/blob/master/lib/Support/YAMLParser.cpp
+ *
+ * .
+ */
+
+#ifndef YANLR_LEXER_CORE_HPP
+#define YANLR_LEXER_CORE_HPP
+
+// -- Macros -------------------------------------------------------------------
+
+// We check the log level before we format the arguments, since the lexer
+// calls these macros in its inner loops.
+#define SPDLOG_TRACE_ON
+#define LOGF(fmt, ...)                                                         \
+  do {                                                                         \
+    if (console->should_log(spdlog::level::trace)) {                           \
+      console->trace("{}:{}: " fmt, __FUNCTION__, __LINE__, __VA_ARGS__);      \
+    }                                                                          \
+  } while (0)
+#define LOG(text)                                                              \
+  do {                                                                         \
+    if (console->should_log(spdlog::level::trace)) {                           \
+      console->trace("{}:{}: {}", __FUNCTION__, __LINE__, text);               \
+    }                                                                          \
+  } while (0)
+
+// -- Imports ------------------------------------------------------------------
+
+#include <antlr4-runtime.h>
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include "CharacterClass.hpp"
+#include "LexerInput.hpp"
+#include "Limits.hpp"
+#include "LineIndex.hpp"
+#include "PositionToken.hpp"
+#include "Selection.hpp"
+
+using std::deque;
+using std::pair;
+using std::shared_ptr;
+using std::stack;
+using std::string;
+using std::unique_ptr;
+
+using antlr4::CharStream;
+using antlr4::CommonToken;
+using antlr4::CommonTokenFactory;
+using antlr4::Token;
+using antlr4::TokenFactory;
+using antlr4::TokenSource;
+
+using spdlog::logger;
+
+// -- Types --------------------------------------------------------------------
+
+/** This enumeration specifies how the lexer handles comments. */
+enum class CommentMode {
+  /** The lexer skips comments without creating tokens. */
+  DROP,
+  /** The lexer puts comment tokens on the hidden channel. */
+  HIDDEN,
+  /**
+   * The lexer puts comment tokens on a hidden channel. Comments that follow
+   * other data in the same line use `TRAILING_COMMENT_CHANNEL`. Listeners
+   * use this distinction to attach comments to the nearest key.
+   */
+  PRESERVE
+};
+
+/** This structure stores the configuration of a lexer. */
+struct LexerSettings {
+  /**
+   * This variable stores the factory that creates tokens without a fixed
+   * position. It is empty, if the lexer uses another kind of factory.
+   */
+  shared_ptr<PositionTokenFactory> positionFactory =
+      std::make_shared<PositionTokenFactory>();
+
+  /** The lexer uses this factory to produce tokens. */
+  Ref<TokenFactory<CommonToken>> factory = positionFactory;
+
+  /** This variable specifies how the lexer handles comments. */
+  CommentMode commentMode = CommentMode::HIDDEN;
+
+  /**
+   * This variable stores the keys requested by a selective parse. If it is
+   * empty, then the lexer scans the whole input.
+   */
+  shared_ptr<Selection> selection;
+
+  /** This variable stores the resource limits for a single document. */
+  Limits limits;
+
+  /**
+   * This variable stores the logger used by the lexer to print debug
+   * messages.
+   */
+  shared_ptr<logger> console;
+
+  /**
+   * @brief This constructor creates the default settings and looks up the
+   *        logger of the lexer.
+   */
+  LexerSettings();
+};
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class stores the scanning logic of the YAML lexer.
+ *
+ * The class template takes the input as policy (`BufferInput` or
+ * `StreamInput`), so the lookahead in the inner loops of the scanner does not
+ * have to go through the virtual methods of `CharStream`. `YAMLLexer` adapts
+ * the cores to the `TokenSource` interface of ANTLR.
+ *
+ * @tparam Input This type provides the methods `LA`, `consume`, `index`,
+ *               `mark`, `release`, `skipToLineEnd` and `sync`.
+ */
+template <typename Input> class LexerCore {
+  /** This variable stores the input that this lexer scans. */
+  Input input;
+
+  /** This variable stores the configuration of the lexer. */
+  LexerSettings const &settings;
+
+  /** This variable stores the logger of the lexer (see `settings`). */
+  logger *console;
+
+  /** This queue stores the list of tokens produced by the lexer. */
+  deque<unique_ptr<CommonToken>> tokens;
+
+  /**
+   * This pair stores the token source (the adapter of this core) and the
+   * current input.
+   */
+  pair<TokenSource *, CharStream *> source;
+
+  /**
+   * This variable stores the start offset of every line the lexer visited.
+   * The lexer and its tokens use it to compute line and column numbers on
+   * request.
+   */
+  shared_ptr<LineIndex> lines;
+
+  /** This number stores the byte offset of the start of the current line. */
+  size_t lineStart = 0;
+
+  /**
+   * This boolean specifies if the current line contains data (besides
+   * comments) before the current input position.
+   */
+  bool lineContainsData = false;
+
+  /**
+   * This counter stores the number of tokens already emitted by the lexer.
+   * The lexer needs this variable, to keep track of the insertion point of
+   * `KEY` tokens in the token queue.
+   */
+  size_t tokensEmitted = 0;
+
+  /**
+   * This stack stores the indentation (in number of characters) for each
+   * block collection.
+   */
+  stack<size_t> indents{deque<size_t>{0}};
+
+  /**
+   * This boolean specifies if the lexer has already scanned the whole input or
+   * not.
+   */
+  bool done = false;
+
+  /**
+   * This constant specifies the maximum length of a simple key in number of
+   * characters.
+   */
+  static const size_t MAXIMUM_SIMPLE_KEY_LENGTH = 1024;
+
+  /**
+   * This pair stores a simple key candidate token (first part) and its
+   * position in the token queue (second part).
+   *
+   * Since the lexer only supports block syntax for mappings and sequences we
+   * use a single token here. If we need support for flow collections we have
+   * to store a candidate for each flow level (block context = flow level 0).
+   */
+  pair<unique_ptr<CommonToken>, size_t> simpleKey;
+
+  /**
+   * This number counts the calls of `fetchTokens` since the lexer last
+   * checked the deadline.
+   */
+  size_t fetchesSinceCheck = 0;
+
+  /**
+   * @brief This function creates a new token with the specified parameters.
+   *
+   * @param type This parameter specifies the type of the token this function
+   *             should create.
+   * @param start This number specifies the start index of the returned token
+   *              inside the character stream `input`.
+   * @param stop This number specifies the stop index of the returned token
+   *             inside the character stream `input`.
+   * @param text This string specifies the text of the returned token.
+   *
+   * @return A token with the specified parameters
+   */
+  unique_ptr<CommonToken> commonToken(size_t type, size_t start, size_t stop,
+                                      string text);
+
+  /**
+   * @brief This function creates a new token with the specified parameters.
+   *
+   * @param type This parameter specifies the type of the token this function
+   *             should create.
+   * @param start This number specifies the start index of the returned token
+   *              inside the character stream `input`.
+   * @param stop This number specifies the stop index of the returned token
+   *             inside the character stream `input`.
+   *
+   * @return A token with the specified parameters
+   */
+  unique_ptr<CommonToken> commonToken(size_t type, size_t start, size_t stop);
+
+  /**
+   * @brief This method returns the current position of the lexer in the
+   *        format of error messages.
+   *
+   * @return The current line and character position of the lexer
+   */
+  string position() const;
+
+  /**
+   * @brief This method checks if the current scalar exceeds the size limit.
+   *
+   * @param start This number specifies the start index of the scalar.
+   *
+   * @throws ParseCancellationException If the scalar is too large
+   */
+  void checkScalarSize(size_t const start) const;
+
+  /**
+   * @brief This function adds an indentation value if the given value is
+   *        smaller than the current indentation.
+   *
+   * @param lineIndex This parameter specifies the indentation value that this
+   *                  function compares to the current indentation.
+   *
+   * @retval true If the function added an indentation value
+   *         false Otherwise
+   */
+  bool addIndentation(size_t const column);
+
+  /**
+   * @brief This function checks if the lexer needs to scan additional tokens.
+   *
+   * @retval true If the lexer should fetch additional tokens
+   *         false Otherwise
+   */
+  bool needMoreTokens() const;
+
+  /**
+   * @brief This method removes the simple key candidate, if it can not start
+   *        a simple key anymore.
+   *
+   * A simple key has to be located on a single line and it must not be longer
+   * than 1024 characters. If the lexer moved past these limits, then the
+   * candidate is stale.
+   */
+  void removeStaleSimpleKey();
+
+  /**
+   * @brief This method adds new tokens to the token stream.
+   */
+  void fetchTokens();
+
+  /**
+   * @brief This method returns the current column of the lexer.
+   *
+   * @return The position (starting with 1) of the lexer inside the current
+   *         line in number of bytes
+   */
+  size_t column() const;
+
+  /**
+   * @brief This method consumes characters from the input stream.
+   *
+   * The consumed characters must not contain a line break. Use
+   * `forwardCharacter` for characters that might be a line break.
+   *
+   * @param characters This parameter specifies the number of characters the
+   *                   the function should consume.
+   */
+  void forward(size_t const characters = 1);
+
+  /**
+   * @brief This method consumes a single character, which might be a line
+   *        break, from the input stream.
+   */
+  void forwardCharacter();
+
+  /**
+   * @brief This method removes uninteresting characters from the input.
+   */
+  void scanToNextToken();
+
+  /**
+   * @brief This method checks if the input at the specified offset starts a key
+   *        value token.
+   *
+   * @param offset This parameter specifies an offset to the current position,
+   *               where this function will look for a key value token.
+   *
+   * @retval true If the input matches a key value token
+   *         false Otherwise
+   */
+  bool isValue(size_t const offset = 1) const;
+
+  /**
+   * @brief This method checks if the current input starts a list element.
+   *
+   * @retval true If the input matches a list element token
+   *         false Otherwise
+   */
+  bool isElement() const;
+
+  /**
+   * @brief This method checks if the input at the specified offset starts a
+   *        line comment.
+   *
+   * @param offset This parameter specifies an offset to the current position,
+   *               where this function will look for a comment token.
+   *
+   * @retval true If the input matches a comment token
+   *         false Otherwise
+   */
+  bool isComment(size_t const offset) const;
+
+  /**
+   * @brief This method saves a token for a simple key candidate located at the
+   *        current input position.
+   */
+  void addSimpleKeyCandidate();
+
+  /**
+   * @brief This method adds block closing tokens to the token queue, if the
+   *        indentation decreased.
+   *
+   * @param lineIndex This parameter specifies the column (indentation in number
+   *                  of spaces) for which this method should add block end
+   *                  tokens.
+   */
+  void addBlockEnd(size_t const lineIndex);
+
+  /**
+   * @brief This method consumes the remainder of the current line without
+   *        creating tokens.
+   *
+   * Quoted scalars that start on the current line might continue on the
+   * following lines. The method consumes the whole scalar in this case.
+   */
+  void skipLine();
+
+  /**
+   * @brief This method consumes the remainder of the current block collection
+   *        entry without creating tokens.
+   *
+   * @param entryColumn This number specifies the column of the key or element
+   *                    that starts the skipped entry. The method stops at the
+   *                    first line (containing data) that is not indented
+   *                    further than this column.
+   */
+  void skipBlock(size_t const entryColumn);
+
+  /**
+   * @brief This method adds the token for the start of the YAML stream to
+   *        `tokens`.
+   */
+  void scanStart();
+
+  /**
+   * @brief This method adds the end markers to the token queue.
+   */
+  void scanEnd();
+
+  /**
+   * @brief This method scans a single quoted scalar and adds it to the token
+   *        queue.
+   */
+  void scanSingleQuotedScalar();
+
+  /**
+   * @brief This method scans a plain scalar and adds it to the token queue.
+   */
+  void scanPlainScalar();
+
+  /**
+   * @brief This method counts the number of non space characters that can be
+   *        part of a plain scalar at position `offset`.
+   *
+   * @param offset This parameter specifies an offset to the current input
+   *               position, where this function searches for non space
+   *               characters.
+   *
+   * @return The number of non-space characters at the input position `offset`
+   */
+  size_t countPlainNonSpace(size_t const offset) const;
+
+  /**
+   * @brief This method counts the number of space characters that can be part
+   *        of a plain scalar at the current input position.
+   *
+   * @return The number of space characters at the current input position
+   */
+  size_t countPlainSpace() const;
+
+  /**
+   * @brief This method scans a comment and adds it to the token queue, unless
+   *        the lexer drops comments.
+   */
+  void scanComment();
+
+  /**
+   * @brief This method scans a double quoted scalar and adds it to the token
+   *        queue.
+   */
+  void scanDoubleQuotedScalar();
+
+  /**
+   * @brief This method scans an anchor (`&name`) or an alias (`*name`) and
+   *        adds it to the token queue.
+   *
+   * @param type This parameter specifies the type of the token this method
+   *             adds (`ANCHOR` or `ALIAS`).
+   */
+  void scanNodeReference(size_t const type);
+
+  /**
+   * @brief This method scans a mapping value token and adds it to the token
+   *        queue.
+   */
+  void scanValue();
+
+  /**
+   * @brief This method scans a list element token and adds it to the token
+   *        queue.
+   */
+  void scanElement();
+
+public:
+  /**
+   * @brief This constructor creates a lexer core without input.
+   *
+   * @param owner This parameter stores the token source that emits the
+   *              tokens of this core.
+   * @param configuration This parameter stores the settings of the lexer,
+   *                      which have to outlive the core.
+   */
+  LexerCore(TokenSource *owner, LexerSettings const &configuration);
+
+  /**
+   * @brief This method resets the state of the lexer, so it can scan a new
+   *        input.
+   *
+   * @param stream This character stream stores the data this lexer scans.
+   * @param scanned This parameter stores the input policy for `stream`.
+   */
+  void reset(CharStream *stream, Input scanned);
+
+  /**
+   * @brief This method retrieves the current (not already emitted) token
+   *        produced by the lexer.
+   *
+   * @return A token of the token stream produced by the lexer
+   */
+  unique_ptr<Token> nextToken();
+
+  /**
+   * @brief This method retrieves the current line index.
+   *
+   * @return The index of the line the lexer is currently scanning
+   */
+  size_t getLine() const;
+
+  /**
+   * @brief This method returns the position in the current line.
+   *
+   * @return The character index in the line the lexer is scanning
+   */
+  size_t getCharPositionInLine() const;
+};
+
+// The source file defines the members of the class template for both inputs
+extern template class LexerCore<BufferInput>;
+extern template class LexerCore<StreamInput>;
+
+#endif // YANLR_LEXER_CORE_HPP
@@ -0,0 +1,190 @@
+#ifndef YANLR_LEXER_INPUT_HPP
+#define YANLR_LEXER_INPUT_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstring>
+
+#include <antlr4-runtime.h>
+
+#include "UTF8InputStream.hpp"
+
+using antlr4::CharStream;
+using antlr4::Token;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides the input of a lexer core for data stored in a
+ *        single contiguous buffer.
+ *
+ * All methods work on a pointer into the buffer of a `UTF8InputStream`, so the
+ * compiler can inline them into the loops of the lexer. The stream itself
+ * only learns the position of the lexer, when the lexer calls `sync` after
+ * the last token.
+ */
+class BufferInput {
+  /** This variable stores the stream that owns the buffer. */
+  UTF8InputStream *stream = nullptr;
+
+  /** This variable points to the first byte of the buffer. */
+  char const *start = nullptr;
+
+  /** This variable points to the next byte of the input. */
+  char const *current = nullptr;
+
+  /** This variable points behind the last byte of the buffer. */
+  char const *end = nullptr;
+
+public:
+  /**
+   * @brief This constructor creates an empty input.
+   */
+  BufferInput() {}
+
+  /**
+   * @brief This constructor creates an input for the data of a stream.
+   *
+   * @param input This parameter stores the stream that owns the data. The
+   *              input starts at the current position of the stream.
+   */
+  explicit BufferInput(UTF8InputStream *input)
+      : stream{input}, start{input->bytes()},
+        current{input->bytes() + input->index()},
+        end{input->bytes() + input->size()} {}
+
+  /**
+   * @brief This method returns the byte at the given offset.
+   *
+   * @param offset This parameter specifies the position of the byte relative
+   *               to the current position (starting with `1`).
+   *
+   * @return The byte at `offset` or `EOF`, if there is no such byte
+   */
+  size_t LA(size_t const offset) const {
+    return offset <= static_cast<size_t>(end - current)
+               ? static_cast<unsigned char>(current[offset - 1])
+               : Token::EOF;
+  }
+
+  /**
+   * @brief This method moves the input to the next byte.
+   *
+   * The caller has to make sure that the input did not reach its end.
+   */
+  void consume() { current++; }
+
+  /**
+   * @brief This method returns the current position of the input.
+   *
+   * @return The byte offset of the next character in the input
+   */
+  size_t index() const { return current - start; }
+
+  /**
+   * @brief This method keeps data starting at the current position. The
+   *        buffer always keeps all data.
+   *
+   * @return A marker for `release`
+   */
+  ssize_t mark() const { return -1; }
+
+  /**
+   * @brief This method releases a marker created by `mark`.
+   */
+  void release(ssize_t) const {}
+
+  /**
+   * @brief This method moves the input to the next line break, or the end
+   *        of the input.
+   */
+  void skipToLineEnd() {
+    auto const lineEnd =
+        static_cast<char const *>(memchr(current, '\n', end - current));
+    current = lineEnd ? lineEnd : end;
+  }
+
+  /**
+   * @brief This method moves the stream to the current position of the
+   *        input.
+   */
+  void sync() const { stream->seek(index()); }
+};
+
+/**
+ * @brief This class provides the input of a lexer core for an arbitrary
+ *        character stream.
+ */
+class StreamInput {
+  /** This variable stores the stream this input reads from. */
+  CharStream *stream = nullptr;
+
+public:
+  /**
+   * @brief This constructor creates an empty input.
+   */
+  StreamInput() {}
+
+  /**
+   * @brief This constructor creates an input for a character stream.
+   *
+   * @param input This parameter stores the stream this object reads from.
+   */
+  explicit StreamInput(CharStream *input) : stream{input} {}
+
+  /**
+   * @brief This method returns the byte at the given offset.
+   *
+   * @param offset This parameter specifies the position of the byte relative
+   *               to the current position (starting with `1`).
+   *
+   * @return The byte at `offset` or `EOF`, if there is no such byte
+   */
+  size_t LA(size_t const offset) const { return stream->LA(offset); }
+
+  /**
+   * @brief This method moves the input to the next byte.
+   */
+  void consume() { stream->consume(); }
+
+  /**
+   * @brief This method returns the current position of the input.
+   *
+   * @return The byte offset of the next character in the input
+   */
+  size_t index() const { return stream->index(); }
+
+  /**
+   * @brief This method makes sure that the stream keeps all data starting at
+   *        the current position, until the marker is released.
+   *
+   * @return A marker for `release`
+   */
+  ssize_t mark() const { return stream->mark(); }
+
+  /**
+   * @brief This method releases a marker created by `mark`.
+   *
+   * @param marker This parameter specifies the released marker.
+   */
+  void release(ssize_t const marker) const { stream->release(marker); }
+
+  /**
+   * @brief This method moves the input to the next line break, or the end
+   *        of the input.
+   */
+  void skipToLineEnd() {
+    size_t character;
+    while ((character = stream->LA(1)) != '\n' && character != Token::EOF) {
+      stream->consume();
+    }
+  }
+
+  /**
+   * @brief This method does nothing, since the stream always stores the
+   *        current position.
+   */
+  void sync() const {}
+};
+
+#endif // YANLR_LEXER_INPUT_HPP
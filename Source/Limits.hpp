@@ -0,0 +1,50 @@
+#ifndef YANLR_LIMITS_HPP
+#define YANLR_LIMITS_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This structure stores the resource limits for parsing a single
+ *        document.
+ *
+ * The lexer and the listeners check these limits, and abort with a
+ * `ParseCancellationException` as soon as the input exceeds one of them. By
+ * default only the number of keys created by aliases is limited.
+ */
+struct Limits {
+  /**
+   * This number specifies the maximum nesting depth of block collections
+   * (and therefore the maximum number of levels of a key name).
+   */
+  size_t depth = SIZE_MAX;
+
+  /** This number specifies the maximum length of the lexer’s token queue. */
+  size_t queue = SIZE_MAX;
+
+  /** This number specifies the maximum size of a scalar in bytes. */
+  size_t scalarBytes = SIZE_MAX;
+
+  /** This number specifies the maximum number of keys of a document. */
+  size_t keys = SIZE_MAX;
+
+  /**
+   * This number specifies the maximum number of keys that aliases can create
+   * in a document. The limit protects against inputs, where nested aliases
+   * grow exponentially (“billion laughs”).
+   */
+  size_t aliasKeys = 1000000;
+
+  /**
+   * This variable specifies the time at which parsing stops. The lexer and
+   * the listeners only check the clock every few hundred tokens or keys.
+   */
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+};
+
+#endif // YANLR_LIMITS_HPP
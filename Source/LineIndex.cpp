@@ -0,0 +1,106 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "LineIndex.hpp"
+
+using std::string;
+using std::upper_bound;
+
+using antlr4::RuntimeException;
+using antlr4::misc::Interval;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates an index for the given input.
+ *
+ * @param stream This character stream stores the indexed input.
+ */
+LineIndex::LineIndex(CharStream *stream) : input{stream} {}
+
+/**
+ * @brief This method adds the start of a new line to the index.
+ *
+ * @param offset This number specifies the byte offset of the first character
+ *               after a line break.
+ */
+void LineIndex::addLine(size_t const offset) {
+  if (offset > lineStarts.back()) {
+    lineStarts.push_back(offset);
+  }
+}
+
+/**
+ * @brief This method returns the start of the line containing the given
+ *        offset.
+ *
+ * @param offset This number specifies a byte offset in the input.
+ *
+ * @return The byte offset of the first character in the line of `offset`
+ */
+size_t LineIndex::lineStart(size_t const offset) const {
+  return lineStarts[line(offset) - 1];
+}
+
+/**
+ * @brief This method returns the line number of the given offset.
+ *
+ * @param offset This number specifies a byte offset in the input.
+ *
+ * @return The line number (starting with 1) of `offset`
+ */
+size_t LineIndex::line(size_t const offset) const {
+  // Most requests refer to the line the lexer is currently scanning
+  if (offset >= lineStarts.back()) {
+    return lineStarts.size();
+  }
+  return upper_bound(lineStarts.begin(), lineStarts.end(), offset) -
+         lineStarts.begin();
+}
+
+/**
+ * @brief This method returns the column of the given offset.
+ *
+ * @param offset This number specifies a byte offset in the input.
+ *
+ * @return The position (starting with 1) of `offset` inside its line in
+ *         number of characters
+ */
+size_t LineIndex::column(size_t const offset) const {
+  return characters(lineStart(offset), offset) + 1;
+}
+
+/**
+ * @brief This method counts the characters between two offsets.
+ *
+ * If the input already dropped the text between the offsets, then the method
+ * returns the number of bytes instead.
+ *
+ * @param start This number specifies the offset of the first counted byte.
+ * @param end This number specifies the offset after the last counted byte.
+ *
+ * @return The number of UTF-8 encoded characters between `start` and `end`
+ */
+size_t LineIndex::characters(size_t const start, size_t const end) const {
+  if (end <= start) {
+    return 0;
+  }
+
+  string text;
+  try {
+    text = input->getText(Interval{start, end - 1});
+  } catch (RuntimeException const &) {
+    return end - start;
+  }
+
+  // We only count the first byte of each character and skip continuation
+  // bytes (`10xxxxxx`)
+  size_t count = 0;
+  for (char const byte : text) {
+    if ((byte & 0xC0) != 0x80) {
+      count++;
+    }
+  }
+  return count;
+}
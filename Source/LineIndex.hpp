@@ -0,0 +1,89 @@
+#ifndef YANLR_LINE_INDEX_HPP
+#define YANLR_LINE_INDEX_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <vector>
+
+#include <antlr4-runtime.h>
+
+using std::vector;
+
+using antlr4::CharStream;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class maps byte offsets of an input to line and column numbers.
+ *
+ * The lexer only reports the start of each line it enters. The index
+ * computes line numbers (via binary search) and columns only if someone asks
+ * for them, for example to print an error message.
+ */
+class LineIndex {
+  /** This variable stores the input that the offsets refer to. */
+  CharStream *input;
+
+  /** This vector stores the byte offset of the first character of each line. */
+  vector<size_t> lineStarts{0};
+
+public:
+  /**
+   * @brief This constructor creates an index for the given input.
+   *
+   * @param stream This character stream stores the indexed input.
+   */
+  LineIndex(CharStream *stream);
+
+  /**
+   * @brief This method adds the start of a new line to the index.
+   *
+   * @param offset This number specifies the byte offset of the first
+   *               character after a line break.
+   */
+  void addLine(size_t const offset);
+
+  /**
+   * @brief This method returns the start of the line containing the given
+   *        offset.
+   *
+   * @param offset This number specifies a byte offset in the input.
+   *
+   * @return The byte offset of the first character in the line of `offset`
+   */
+  size_t lineStart(size_t const offset) const;
+
+  /**
+   * @brief This method returns the line number of the given offset.
+   *
+   * @param offset This number specifies a byte offset in the input.
+   *
+   * @return The line number (starting with 1) of `offset`
+   */
+  size_t line(size_t const offset) const;
+
+  /**
+   * @brief This method returns the column of the given offset.
+   *
+   * @param offset This number specifies a byte offset in the input.
+   *
+   * @return The position (starting with 1) of `offset` inside its line in
+   *         number of characters
+   */
+  size_t column(size_t const offset) const;
+
+  /**
+   * @brief This method counts the characters between two offsets.
+   *
+   * If the input already dropped the text between the offsets, then the
+   * method returns the number of bytes instead.
+   *
+   * @param start This number specifies the offset of the first counted byte.
+   * @param end This number specifies the offset after the last counted byte.
+   *
+   * @return The number of UTF-8 encoded characters between `start` and `end`
+   */
+  size_t characters(size_t const start, size_t const end) const;
+};
+
+#endif // YANLR_LINE_INDEX_HPP
@@ -1,58 +1,351 @@
 // -- Imports ------------------------------------------------------------------
 
+#include "Conversion.hpp"
 #include "Listener.hpp"
+#include "YAMLLexer.hpp"
+
+using antlr4::ParseCancellationException;
 
 // -- Functions ----------------------------------------------------------------
 
 namespace {
 
 /**
- * @brief This function converts a given number to an array base name.
+ * @brief This function searches the position of a key in a key set.
+ *
+ * The key set stores the keys below a key directly after this key, so the
+ * function also returns the position of the first key below `key`, if
+ * `keys` does not contain `key` itself.
+ *
+ * @param keys This parameter stores the searched key set.
+ * @param key This parameter stores the key this function searches.
+ *
+ * @return The position of the first key in `keys` that is not smaller than
+ *         `key` or the size of `keys`, if there is no such key
+ */
+ssize_t lowerBound(CppKeySet const &keys, CppKey const &key) {
+  ssize_t first = 0;
+  ssize_t last = keys.size();
+  while (first < last) {
+    ssize_t const middle = first + (last - first) / 2;
+    if (keys.at(middle) < key) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+  return first;
+}
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new empty key storage using the given
+ *        parent key.
+ *
+ * @param parent This key specifies the parent of all keys stored in the
+ *               object.
+ */
+KeyListener::KeyListener(CppKey parent) : keys{}, lastKey{parent} {
+  parents.push(parent);
+}
+
+/**
+ * @brief This method removes all keys from the storage and sets a new parent
+ *        key.
+ *
+ * @param parent This key specifies the parent of all keys stored in the
+ *               object.
+ */
+void KeyListener::reset(CppKey parent) {
+  keys = CppKeySet{};
+  resetLayer(parent);
+  layered = false;
+}
+
+/**
+ * @brief This method keeps all keys of the storage and prepares the listener
+ *        to apply the next document on top of them.
+ *
+ * Scalars and sequences of the next document replace the data of the stored
+ * keys, while mappings merge with stored mappings. The listener removes
+ * replaced keys before it adds the new ones, so it never copies data of
+ * earlier documents. Merge keys (`<<`) do not replace stored keys, and
+ * anchored mappings include the stored keys they merged with.
+ *
+ * @param parent This key specifies the parent of all keys stored in the
+ *               object.
+ */
+void KeyListener::resetLayer(CppKey parent) {
+  parents = stack<CppKey>{};
+  indices = stack<uintmax_t>{};
+  mappings = stack<unordered_map<string, Token *>>{};
+  comments.clear();
+  nextComment = 0;
+  lastKey = parent;
+  anchors.clear();
+  aliasKeys = 0;
+  keysSinceCheck = 0;
+  layered = true;
+  parents.push(parent);
+}
+
+/**
+ * @brief This method specifies the comments of the input.
+ *
+ * The listener attaches each comment to the nearest key, using the metadata
+ * `comment/#0`, `comment/#1`, …. Without comments the listener does not add any
+ * comment metadata.
+ *
+ * @param tokens This parameter stores the comment tokens of the input. The
+ *               lexer has to preserve comments (`CommentMode::PRESERVE`),
+ *               otherwise the listener is not able to distinguish trailing
+ *               comments from other comments.
+ */
+void KeyListener::setComments(vector<Token *> tokens) {
+  comments = move(tokens);
+  nextComment = 0;
+}
+
+/**
+ * @brief This method specifies how the listener stores the type of scalars.
+ *
+ * Only plain scalars have a type other than string. Null scalars always become
+ * keys without a value (binary null), if the listener resolves types.
+ *
+ * @param mode This parameter specifies the new resolution mode.
+ */
+void KeyListener::setTypeResolution(TypeResolution const mode) {
+  resolution = mode;
+}
+
+/**
+ * @brief This method specifies the resource limits for a single document.
  *
- * @param index This number specifies the index of the array entry.
+ * The listener checks the nesting depth, the number of keys, the number of
+ * keys created by aliases and the deadline.
  *
- * @return A string representing the given indices as Elektra array name.
+ * @param documentLimits This parameter stores the new limits.
  */
-string indexToArrayBaseName(uintmax_t const index) {
-  size_t digits = 1;
+void KeyListener::setLimits(Limits const &documentLimits) {
+  limits = documentLimits;
+}
 
-  for (uintmax_t value = index; value > 9; digits++) {
-    value /= 10;
+/**
+ * @brief This method adds a key to the key set and checks the limits.
+ *
+ * @param key This parameter stores the key this method adds.
+ *
+ * @throws ParseCancellationException If the key set exceeds the key limit or
+ *                                    the deadline passed
+ */
+void KeyListener::addKey(CppKey const &key) {
+  keys.append(key);
+  if (static_cast<size_t>(keys.size()) > limits.keys) {
+    throw ParseCancellationException("Number of keys exceeds the limit of " +
+                                     to_string(limits.keys));
+  }
+  // Reading the clock for every key would be too expensive
+  if (++keysSinceCheck >= 256) {
+    keysSinceCheck = 0;
+    if (std::chrono::steady_clock::now() > limits.deadline) {
+      throw ParseCancellationException("Converting the parse tree to keys "
+                                       "exceeded the deadline");
+    }
   }
+}
 
-  return "#" + string(digits - 1, '_') + to_string(index);
+/**
+ * @brief This method checks if the current nesting depth allows one more
+ *        level.
+ *
+ * @param token This parameter stores the token that starts the new level.
+ *
+ * @throws ParseCancellationException If the new level exceeds the depth limit
+ */
+void KeyListener::checkDepth(Token *token) const {
+  // The stack also contains the parent key, which does not count as level
+  if (parents.size() > limits.depth) {
+    throw ParseCancellationException(
+        ErrorListener::position(token) +
+        " Nesting depth exceeds the limit of " + to_string(limits.depth));
+  }
 }
 
 /**
- * @brief This function converts a YAML scalar to a string.
+ * @brief This method copies the keys of an anchored node to the current key.
  *
- * @param text This string contains a YAML scalar (including quote
- *             characters).
+ * If the current key is a merge key (`<<`), then the method copies the keys to
+ * the parent of the merge key instead. Merged keys do not replace existing
+ * keys.
  *
- * @return A string without leading and trailing quote characters
+ * @param alias This parameter stores the alias token.
+ *
+ * @throws ParseCancellationException If the anchor of `alias` does not exist
+ *                                    or the copied keys exceed the alias limit
  */
-string scalarToText(string const &text) {
-  if (text.length() == 0) {
-    return text;
+void KeyListener::expandAlias(Token *alias) {
+  string const name = alias->getText().substr(1);
+  string const position = ErrorListener::position(alias) + " ";
+  auto anchor = anchors.find(name);
+  if (anchor == anchors.end()) {
+    throw ParseCancellationException(position + "Unknown alias “" + name +
+                                     "”");
+  }
+
+  size_t const size = static_cast<size_t>(anchor->second.keys.size());
+  if (size > limits.aliasKeys - aliasKeys) {
+    throw ParseCancellationException(
+        position + "Expanding alias “" + name + "” exceeds the limit of " +
+        to_string(limits.aliasKeys) + " keys created by aliases");
+  }
+  aliasKeys += size;
+
+  string target = parents.top().getName();
+  bool const merge = mergeKey;
+  if (merge) {
+    target.resize(target.size() - string{"/<<"}.size());
   }
-  if (*(text.begin()) == '"' || *(text.begin()) == '\'') {
-    return text.substr(1, text.length() - 2);
+
+  // The keys of the anchor are already complete, so we only need to replace
+  // the prefix of their names
+  size_t const rootLength = anchor->second.root.getName().size();
+  for (auto key : anchor->second.keys) {
+    string const copyName = target + key.getName().substr(rootLength);
+    if (merge && keys.lookup(copyName)) {
+      continue;
+    }
+    CppKey copy{key.dup()};
+    copy.setName(copyName);
+    addKey(copy);
   }
-  return text;
 }
 
-} // namespace
+/**
+ * @brief This method removes the keys earlier layers stored at and below the
+ *        given key, if the given node replaces them.
+ *
+ * A mapping only replaces values (including `null`) and sequences, and
+ * keeps the keys of an earlier mapping. All other nodes replace the data
+ * of earlier layers completely.
+ *
+ * @param key This parameter stores the key of the node.
+ * @param node This parameter stores the node or `nullptr` for an empty value.
+ */
+void KeyListener::replace(CppKey const &key, ChildContext *node) {
+  if (!layered) {
+    return;
+  }
+  ssize_t const position = lowerBound(keys, key);
+  if (position == keys.size() || !keys.at(position).isBelowOrSame(key)) {
+    return;
+  }
 
-// -- Class --------------------------------------------------------------------
+  // Earlier mappings store their data in the keys below their key, which
+  // (if it exists) stores no value. Keys without children store a value.
+  CppKey const stored = keys.at(position);
+  bool const mapping =
+      stored.isBelow(key) ||
+      (position + 1 < keys.size() && keys.at(position + 1).isBelow(key) &&
+       !stored.isBinary() && !stored.hasMeta("array"));
+  // Cutting the keys copies them, so we only cut replaced data
+  if (!mapping || !node || !node->map()) {
+    keys.cut(key);
+  }
+}
 
 /**
- * @brief This constructor creates a new empty key storage using the given
- *        parent key.
+ * @brief This method stores the value of a scalar in a key.
  *
- * @param parent This key specifies the parent of all keys stored in the
- *               object.
+ * @param key This parameter stores the key this method modifies.
+ * @param context This parameter stores the scalar.
+ */
+void KeyListener::setValue(CppKey &key, ValueContext *context) const {
+  string const text = scalarToText(context->getText());
+  // Quoted scalars are always strings
+  if (resolution == TypeResolution::NONE || !context->scalar()->PLAIN_SCALAR()) {
+    key.setString(text);
+    return;
+  }
+
+  ResolvedScalar const scalar = resolveScalar(text);
+  if (scalar.type == ScalarType::STRING) {
+    key.setString(text);
+    return;
+  } else if (scalar.type == ScalarType::NULL_VALUE) {
+    key.setBinary(nullptr, 0);
+    return;
+  }
+
+  if (resolution == TypeResolution::METADATA) {
+    key.setString(text);
+  } else if (scalar.type == ScalarType::BOOLEAN) {
+    key.setBinary(&scalar.boolean, sizeof(scalar.boolean));
+  } else if (scalar.type == ScalarType::INTEGER) {
+    key.setBinary(&scalar.integer, sizeof(scalar.integer));
+  } else {
+    key.setBinary(&scalar.floating, sizeof(scalar.floating));
+  }
+  key.setMeta("type", string{typeName(scalar.type)});
+}
+
+/**
+ * @brief This method attaches all unassigned comments in front of the given
+ *        token as metadata.
+ *
+ * Comments that follow other data on the same line belong to `lastKey`. All
+ * other comments belong to the given key.
+ *
+ * @param tokenIndex This parameter specifies the index of the first token that
+ *                   is not part of the attached comments.
+ * @param key This parameter specifies the key that follows the comments.
+ */
+void KeyListener::attachComments(size_t const tokenIndex, CppKey &key) {
+  for (; nextComment < comments.size() &&
+         comments[nextComment]->getTokenIndex() < tokenIndex;
+       nextComment++) {
+    Token *comment = comments[nextComment];
+    CppKey &owner =
+        comment->getChannel() == YAMLLexer::TRAILING_COMMENT_CHANNEL ? lastKey
+                                                                     : key;
+    uintmax_t index = 0;
+    while (owner.hasMeta("comment/" + indexToArrayBaseName(index))) {
+      index++;
+    }
+    // We store the text after the comment indicator `#`
+    owner.setMeta("comment/" + indexToArrayBaseName(index),
+                  comment->getText().substr(1));
+    // Keys that only store other keys (mappings) are not part of the key set
+    // otherwise
+    addKey(owner);
+  }
+}
+
+/**
+ * @brief This function will be called after the parser enters the YAML
+ *        document.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::enterYaml(YamlContext *context) {
+  // An empty document does not replace anything
+  if (context->child()) {
+    replace(parents.top(), context->child());
+  }
+}
+
+/**
+ * @brief This function will be called after the parser exits the YAML
+ *        document.
+ *
+ * @param context The context specifies data matched by the rule.
  */
-KeyListener::KeyListener(CppKey parent) : keys{} { parents.push(parent); }
+void KeyListener::exitYaml(YamlContext *context __attribute__((unused))) {
+  // Comments at the end of the document belong to the last key
+  attachComments(SIZE_MAX, lastKey);
+}
 
 /**
  * @brief This function returns the data read by the parser.
@@ -61,6 +354,34 @@ KeyListener::KeyListener(CppKey parent) : keys{} { parents.push(parent); }
  */
 CppKeySet KeyListener::keySet() { return keys; }
 
+/**
+ * @brief This function will be called after the parser enters a child node.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::enterChild(ChildContext *context) {
+  if (context->ALIAS()) {
+    expandAlias(context->ALIAS()->getSymbol());
+  }
+}
+
+/**
+ * @brief This function will be called after the parser exits a child node.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::exitChild(ChildContext *context) {
+  if (!context->ANCHOR()) {
+    return;
+  }
+  // We store the keys of the anchored node once. Aliases copy them without
+  // visiting the node again.
+  CppKey const &root = parents.top();
+  CppKeySet anchored = keys.cut(root);
+  keys.append(anchored);
+  anchors[context->ANCHOR()->getText().substr(1)] = Anchor{root, anchored};
+}
+
 /**
  * @brief This function will be called after the parser exits a value.
  *
@@ -68,25 +389,63 @@ CppKeySet KeyListener::keySet() { return keys; }
  */
 void KeyListener::exitValue(ValueContext *context) {
   CppKey key = parents.top();
-  key.setString(scalarToText(context->getText()));
-  keys.append(key);
+  attachComments(context->getStart()->getTokenIndex(), key);
+  lastKey = key;
+  setValue(key, context);
+  addKey(key);
+}
+
+/**
+ * @brief This function will be called after the parser enters a mapping.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::enterMap(MapContext *context __attribute__((unused))) {
+  mappings.push(unordered_map<string, Token *>{});
+}
+
+/**
+ * @brief This function will be called after the parser exits a mapping.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void KeyListener::exitMap(MapContext *context __attribute__((unused))) {
+  mappings.pop();
 }
 
 /**
  * @brief This function will be called after the parser enters a key-value pair.
  *
  * @param context The context specifies data matched by the rule.
+ *
+ * @throws ParseCancellationException If the mapping already contains the key
+ *                                    of the pair
  */
 void KeyListener::enterPair(PairContext *context) {
   // Entering a mapping such as `part: …` means that we need to add `part` to
   // the key name
+  checkDepth(context->key()->getStart());
+  string const name = scalarToText(context->key()->getText());
+  auto inserted = mappings.top().insert({name, context->key()->getStart()});
+  if (!inserted.second) {
+    throw ParseCancellationException(
+        ErrorListener::position(context->key()->getStart()) +
+        " Duplicate key “" + name + "” (first occurrence at " +
+        ErrorListener::position(inserted.first->second) + ")");
+  }
+
   CppKey child{parents.top().getName(), KEY_END};
-  child.addBaseName(scalarToText(context->key()->getText()));
+  child.addBaseName(name);
+  // Quoted scalars such as `'<<'` are ordinary keys
+  mergeKey = name == "<<" && context->key()->scalar()->PLAIN_SCALAR();
+  replace(child, context->child());
+  attachComments(context->KEY()->getSymbol()->getTokenIndex(), child);
+  lastKey = child;
   parents.push(child);
   if (!context->child()) {
     // Add key with empty value
     // The parser does not visit `exitValue` in that case
-    keys.append(child);
+    addKey(child);
   }
 }
 
@@ -99,6 +458,7 @@ void KeyListener::exitPair(PairContext *context __attribute__((unused))) {
   // Returning from a mapping such as `part: …` means that we need need to
   // remove the key for `part` from the stack.
   parents.pop();
+  mergeKey = false;
 }
 
 /**
@@ -120,7 +480,7 @@ void KeyListener::enterSequence(SequenceContext *context
 void KeyListener::exitSequence(SequenceContext *context
                                __attribute__((unused))) {
   // We add the parent key of all array elements after we leave the sequence
-  keys.append(parents.top());
+  addKey(parents.top());
   indices.pop();
 }
 
@@ -130,11 +490,13 @@ void KeyListener::exitSequence(SequenceContext *context
  *
  * @param context The context specifies data matched by the rule.
  */
-void KeyListener::enterElement(ElementContext *context
-                               __attribute__((unused))) {
-
+void KeyListener::enterElement(ElementContext *context) {
+  checkDepth(context->ELEMENT()->getSymbol());
+  mergeKey = false;
   CppKey key{parents.top().getName(), KEY_END};
   key.addBaseName(indexToArrayBaseName(indices.top()));
+  attachComments(context->ELEMENT()->getSymbol()->getTokenIndex(), key);
+  lastKey = key;
 
   uintmax_t index = indices.top();
   indices.pop();
@@ -1,16 +1,32 @@
+#ifndef YANLR_LISTENER_HPP
+#define YANLR_LISTENER_HPP
+
 // -- Imports ------------------------------------------------------------------
 
 #include <stack>
+#include <unordered_map>
+#include <vector>
 
 #include <kdb.hpp>
 
 #include "YAMLBaseListener.h"
 
+#include "ErrorListener.hpp"
+#include "Limits.hpp"
+#include "ScalarType.hpp"
+
 using std::stack;
 using std::string;
 using std::to_string;
+using std::unordered_map;
+using std::vector;
+
+using antlr4::Token;
 
 using antlr::YAMLBaseListener;
+using YamlContext = antlr::YAML::YamlContext;
+using ChildContext = antlr::YAML::ChildContext;
+using MapContext = antlr::YAML::MapContext;
 using ValueContext = antlr::YAML::ValueContext;
 using PairContext = antlr::YAML::PairContext;
 using SequenceContext = antlr::YAML::SequenceContext;
@@ -40,6 +56,134 @@ class KeyListener : public YAMLBaseListener {
    */
   stack<uintmax_t> indices;
 
+  /**
+   * This stack stores the keys of each mapping we are currently inside. Each
+   * key (base name) points to the token of its first occurrence.
+   */
+  stack<unordered_map<string, Token *>> mappings;
+
+  /**
+   * This vector stores the comment tokens of the input in the order of their
+   * token index.
+   */
+  vector<Token *> comments;
+
+  /** This number stores the index of the next unassigned comment. */
+  size_t nextComment = 0;
+
+  /**
+   * This variable stores the key, which the last key-value pair, element or
+   * value belongs to. Trailing comments belong to this key.
+   */
+  CppKey lastKey;
+
+  /** This variable specifies how the listener stores the type of scalars. */
+  TypeResolution resolution = TypeResolution::NONE;
+
+  /** This structure stores the data of an anchored node. */
+  struct Anchor {
+    /** This key stores the name of the anchored node. */
+    CppKey root;
+    /** This key set stores the keys at and below `root`. */
+    CppKeySet keys;
+  };
+
+  /** This map stores the anchored nodes of the input by anchor name. */
+  unordered_map<string, Anchor> anchors;
+
+  /**
+   * This boolean specifies if the current key is a merge key (a plain `<<`
+   * scalar).
+   */
+  bool mergeKey = false;
+
+  /** This number stores the number of keys created by aliases. */
+  size_t aliasKeys = 0;
+
+  /** This variable stores the resource limits for a single document. */
+  Limits limits;
+
+  /** This number counts the keys added since the last deadline check. */
+  size_t keysSinceCheck = 0;
+
+  /**
+   * This boolean specifies if the current document overrides the keys of
+   * earlier documents.
+   */
+  bool layered = false;
+
+  /**
+   * @brief This method adds a key to the key set and checks the limits.
+   *
+   * @param key This parameter stores the key this method adds.
+   *
+   * @throws ParseCancellationException If the key set exceeds the key limit
+   *                                    or the deadline passed
+   */
+  void addKey(CppKey const &key);
+
+  /**
+   * @brief This method checks if the current nesting depth allows one more
+   *        level.
+   *
+   * @param token This parameter stores the token that starts the new level.
+   *
+   * @throws ParseCancellationException If the new level exceeds the depth
+   *                                    limit
+   */
+  void checkDepth(Token *token) const;
+
+  /**
+   * @brief This method copies the keys of an anchored node to the current
+   *        key.
+   *
+   * If the current key is a merge key (`<<`), then the method copies the keys
+   * to the parent of the merge key instead. Merged keys do not replace
+   * existing keys.
+   *
+   * @param alias This parameter stores the alias token.
+   *
+   * @throws ParseCancellationException If the anchor of `alias` does not exist
+   *                                    or the copied keys exceed the alias
+   *                                    limit
+   */
+  void expandAlias(Token *alias);
+
+  /**
+   * @brief This method removes the keys earlier layers stored at and below
+   *        the given key, if the given node replaces them.
+   *
+   * A mapping only replaces values (including `null`) and sequences, and
+   * keeps the keys of an earlier mapping. All other nodes replace the data
+   * of earlier layers completely.
+   *
+   * @param key This parameter stores the key of the node.
+   * @param node This parameter stores the node or `nullptr` for an empty
+   *             value.
+   */
+  void replace(CppKey const &key, ChildContext *node);
+
+  /**
+   * @brief This method stores the value of a scalar in a key.
+   *
+   * @param key This parameter stores the key this method modifies.
+   * @param context This parameter stores the scalar.
+   */
+  void setValue(CppKey &key, ValueContext *context) const;
+
+  /**
+   * @brief This method attaches all unassigned comments in front of the given
+   *        token as metadata.
+   *
+   * Comments that follow other data on the same line belong to `lastKey`.
+   * All other comments belong to the given key.
+   *
+   * @param tokenIndex This parameter specifies the index of the first token
+   *                   that is not part of the attached comments.
+   * @param key This parameter specifies the key that follows the comments.
+   */
+  void attachComments(size_t const tokenIndex, CppKey &key);
+
 public:
   /**
    * @brief This constructor creates a new empty key storage using the given
@@ -50,6 +194,66 @@ public:
    */
   KeyListener(CppKey parent);
 
+  /**
+   * @brief This method removes all keys from the storage and sets a new
+   *        parent key.
+   *
+   * @param parent This key specifies the parent of all keys stored in the
+   *               object.
+   */
+  void reset(CppKey parent);
+
+  /**
+   * @brief This method keeps all keys of the storage and prepares the
+   *        listener to apply the next document on top of them.
+   *
+   * Scalars and sequences of the next document replace the data of the
+   * stored keys, while mappings merge with stored mappings. The listener
+   * removes replaced keys before it adds the new ones, so it never copies
+   * data of earlier documents. Merge keys (`<<`) do not replace stored keys,
+   * and anchored mappings include the stored keys they merged with.
+   *
+   * @param parent This key specifies the parent of all keys stored in the
+   *               object.
+   */
+  void resetLayer(CppKey parent);
+
+  /**
+   * @brief This method specifies the comments of the input.
+   *
+   * The listener attaches each comment to the nearest key, using the metadata
+   * `comment/#0`, `comment/#1`, …. Without comments the listener does not add
+   * any comment metadata.
+   *
+   * @param tokens This parameter stores the comment tokens of the input. The
+   *               lexer has to preserve comments
+   *               (`CommentMode::PRESERVE`), otherwise the listener is not
+   *               able to distinguish trailing comments from other comments.
+   */
+  void setComments(vector<Token *> tokens);
+
+  /**
+   * @brief This method specifies how the listener stores the type of
+   *        scalars.
+   *
+   * Only plain scalars have a type other than string. Null scalars always
+   * become keys without a value (binary null), if the listener resolves
+   * types.
+   *
+   * @param mode This parameter specifies the new resolution mode.
+   */
+  void setTypeResolution(TypeResolution const mode);
+
+  /**
+   * @brief This method specifies the resource limits for a single document.
+   *
+   * The listener checks the nesting depth, the number of keys, the number of
+   * keys created by aliases and the deadline.
+   *
+   * @param documentLimits This parameter stores the new limits.
+   */
+  void setLimits(Limits const &documentLimits);
+
   /**
    * @brief This function returns the data read by the parser.
    *
@@ -57,6 +261,37 @@ public:
    */
   CppKeySet keySet();
 
+  /**
+   * @brief This function will be called after the parser enters the YAML
+   *        document.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterYaml(YamlContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits the YAML
+   *        document.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitYaml(YamlContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a child
+   *        node.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterChild(ChildContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a child node.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitChild(ChildContext *context) override;
+
   /**
    * @brief This function will be called after the parser exits a value.
    *
@@ -64,11 +299,28 @@ public:
    */
   void exitValue(ValueContext *context) override;
 
+  /**
+   * @brief This function will be called after the parser enters a mapping.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterMap(MapContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a mapping.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitMap(MapContext *context) override;
+
   /**
    * @brief This function will be called after the parser enters a key-value
    *        pair.
    *
    * @param context The context specifies data matched by the rule.
+   *
+   * @throws ParseCancellationException If the mapping already contains the
+   *                                    key of the pair
    */
   virtual void enterPair(PairContext *context) override;
 
@@ -110,3 +362,5 @@ public:
    */
   virtual void exitElement(ElementContext *context) override;
 };
+
+#endif // YANLR_LISTENER_HPP
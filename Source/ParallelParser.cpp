@@ -0,0 +1,382 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <exception>
+#include <thread>
+#include <unordered_set>
+
+#include "Conversion.hpp"
+#include "ParallelParser.hpp"
+
+using std::exception_ptr;
+using std::current_exception;
+using std::thread;
+using std::to_string;
+using std::unordered_set;
+
+using antlr4::ParseCancellationException;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function returns the position after a quoted scalar.
+ *
+ * @param text This parameter stores YAML data.
+ * @param position This number specifies the position of the opening quote.
+ *
+ * @return The position after the closing quote or the size of `text`, if the
+ *         scalar is unterminated
+ */
+size_t skipQuoted(string const &text, size_t position) {
+  char const quote = text[position++];
+  while (position < text.size()) {
+    if (quote == '"' && text[position] == '\\') {
+      position += 2; // Escape sequence
+    } else if (text[position] != quote) {
+      position++;
+    } else if (quote == '\'' && position + 1 < text.size() &&
+               text[position + 1] == '\'') {
+      position += 2; // Escaped single quote
+    } else {
+      return position + 1;
+    }
+  }
+  return text.size();
+}
+
+/**
+ * @brief This function checks if the given position starts a value indicator
+ *        (`: ` or `:` followed by a newline).
+ *
+ * @param text This parameter stores YAML data.
+ * @param position This number specifies the checked position.
+ *
+ * @retval true If `position` starts a value indicator
+ *         false Otherwise
+ */
+bool isValue(string const &text, size_t const position) {
+  return position + 1 < text.size() && text[position] == ':' &&
+         (text[position + 1] == ' ' || text[position + 1] == '\n');
+}
+
+/**
+ * @brief This function returns the position after the given scalar.
+ *
+ * @param text This parameter stores YAML data.
+ * @param position This number specifies the start of the scalar.
+ *
+ * @return The position after the quoted scalar or plain scalar starting at
+ *         `position`
+ */
+size_t skipScalar(string const &text, size_t position) {
+  if (text[position] == '"' || text[position] == '\'') {
+    return skipQuoted(text, position);
+  }
+
+  // Plain scalars end at the line end, a value indicator or a comment
+  while (position < text.size() && text[position] != '\n' &&
+         !isValue(text, position) &&
+         !(text[position] == ' ' && position + 2 < text.size() &&
+           text[position + 1] == '#' &&
+           (text[position + 2] == ' ' || text[position + 2] == '\n'))) {
+    position++;
+  }
+  return position;
+}
+
+/**
+ * @brief This function returns the position after the current line.
+ *
+ * @param text This parameter stores YAML data.
+ * @param position This number specifies a position at the start of a token.
+ *
+ * @return The start of the next line, or the size of `text`, if the current
+ *         line is the last line. If a quoted scalar continues on the following
+ *         lines, then the function returns the line after the scalar.
+ */
+size_t skipLine(string const &text, size_t position) {
+  while (position < text.size()) {
+    char const character = text[position];
+    if (character == ' ') {
+      position++;
+    } else if (character == '\n') {
+      return position + 1;
+    } else if (character == '#') {
+      position = text.find('\n', position);
+    } else if (character == '-' && position + 1 < text.size() &&
+               (text[position + 1] == ' ' || text[position + 1] == '\n')) {
+      position++;
+    } else if (isValue(text, position)) {
+      position++;
+    } else {
+      position = skipScalar(text, position);
+    }
+  }
+  return text.size();
+}
+
+/**
+ * @brief This function checks if the given position starts a simple key.
+ *
+ * @param text This parameter stores YAML data.
+ * @param position This number specifies the start of the checked line.
+ *
+ * @retval true If `position` starts a scalar followed by a value indicator on
+ *              the same line
+ *         false Otherwise
+ */
+bool isKey(string const &text, size_t position) {
+  if (isValue(text, position) || text[position] == '-' ||
+      text[position] == '#') {
+    return false;
+  }
+  size_t const end = skipScalar(text, position);
+  if (text.find('\n', position) < end) {
+    return false; // Simple keys must not span multiple lines
+  }
+  position = end;
+  while (position < text.size() && text[position] == ' ') {
+    position++;
+  }
+  return isValue(text, position);
+}
+
+/**
+ * @brief This function returns the (unquoted) text of a simple key.
+ *
+ * @param text This parameter stores YAML data.
+ * @param position This number specifies the start of the key.
+ *
+ * @return The text of the key starting at `position`
+ */
+string keyName(string const &text, size_t const position) {
+  size_t end = skipScalar(text, position);
+  while (end > position && text[end - 1] == ' ') {
+    end--; // Plain scalars do not contain trailing spaces
+  }
+  return scalarToText(text.substr(position, end - position));
+}
+
+/**
+ * @brief This function returns the start of the comments in front of a key.
+ *
+ * Listeners attach comments on the lines in front of a key to this key. A
+ * chunk that starts with a key therefore also has to contain these comments.
+ *
+ * @param text This parameter stores YAML data.
+ * @param previous This number specifies the start of a line in front of
+ *                 `key`, which does not belong to a quoted scalar.
+ * @param key This number specifies the start of the line of a key.
+ *
+ * @return The start of the first line of the comment (and empty) lines
+ *         directly in front of `key`, or `key`, if there are no such lines
+ */
+size_t commentStart(string const &text, size_t const previous,
+                    size_t const key) {
+  size_t start = key;
+  size_t position = previous;
+  while (position < key) {
+    size_t content = position;
+    while (content < text.size() && text[content] == ' ') {
+      content++;
+    }
+    bool const empty = content >= text.size() || text[content] == '\n' ||
+                       text[content] == '#';
+    if (!empty) {
+      start = key;
+    } else if (start == key) {
+      start = position;
+    }
+    // `skipLine` also skips quoted scalars that span multiple lines
+    position = skipLine(text, content);
+  }
+  return start;
+}
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new parallel parser.
+ *
+ * @param threads This number specifies the maximum number of threads the
+ *                parser uses.
+ */
+ParallelParser::ParallelParser(size_t const threads) {
+  // We create all parsers (and their lexers) on the calling thread, since the
+  // first lexer also creates the shared logger.
+  for (size_t parser = 0; parser < (threads > 0 ? threads : 1); parser++) {
+    parsers.push_back(unique_ptr<Parser>{new Parser{}});
+  }
+}
+
+/**
+ * @brief This method specifies how the parser handles comments.
+ *
+ * @param mode This parameter specifies the new comment mode.
+ */
+void ParallelParser::setCommentMode(CommentMode const mode) {
+  for (auto &parser : parsers) {
+    parser->setCommentMode(mode);
+  }
+}
+
+/**
+ * @brief This method specifies how `parse` stores the type of scalars.
+ *
+ * @param mode This parameter specifies the new resolution mode.
+ */
+void ParallelParser::setTypeResolution(TypeResolution const mode) {
+  for (auto &parser : parsers) {
+    parser->setTypeResolution(mode);
+  }
+}
+
+/**
+ * @brief This method specifies the resource limits for a single document.
+ *
+ * Every chunk has to stay below the limits, and the key limit also applies to
+ * the merged key set.
+ *
+ * @param documentLimits This parameter stores the new limits.
+ */
+void ParallelParser::setLimits(Limits const &documentLimits) {
+  limits = documentLimits;
+  for (auto &parser : parsers) {
+    parser->setLimits(limits);
+  }
+}
+
+/**
+ * @brief This function returns the start offsets of all top level keys.
+ *
+ * The function only checks the first line of each top level entry, and it
+ * skips quoted scalars and comments the same way the lexer does.
+ *
+ * @param text This parameter stores YAML data.
+ *
+ * @return The byte offsets of all lines that start with a key in the first
+ *         column or an empty list, if the top level of `text` is not a block
+ *         mapping starting in the first column
+ */
+vector<size_t> ParallelParser::topLevelKeys(string const &text) {
+  vector<size_t> keys;
+  size_t position = 0;
+  while (position < text.size()) {
+    size_t start = position;
+    while (position < text.size() && text[position] == ' ') {
+      position++;
+    }
+    if (position >= text.size()) {
+      break;
+    }
+
+    if (text[position] != '\n' && text[position] != '#') {
+      if (position == start && isKey(text, position)) {
+        keys.push_back(start);
+      } else if (position == start || keys.empty()) {
+        // The top level is not a mapping in the first column
+        return {};
+      }
+    }
+    position = skipLine(text, position);
+  }
+  return keys;
+}
+
+/**
+ * @brief This method converts the given YAML data to a key set.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param parent This key specifies the parent of all keys stored in the
+ *               returned key set.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML data
+ *                                    or exceeds one of the limits
+ *
+ * @return A key set that represents the given YAML data
+ */
+CppKeySet ParallelParser::parse(string const &bytes, CppKey const &parent) {
+  vector<size_t> keys =
+      parsers.size() > 1 ? topLevelKeys(bytes) : vector<size_t>{};
+
+  // We split the input into chunks of (roughly) the same size. Every chunk
+  // starts with the comments in front of its first key, so the listener
+  // attaches them to the same key as the sequential parser.
+  vector<size_t> chunks{0};
+  for (size_t chunk = 1; chunk < parsers.size(); chunk++) {
+    size_t const target = bytes.size() / parsers.size() * chunk;
+    for (size_t index = 1; index < keys.size(); index++) {
+      if (keys[index] >= target) {
+        size_t const start = commentStart(bytes, keys[index - 1], keys[index]);
+        if (start > chunks.back()) {
+          chunks.push_back(start);
+        }
+        break;
+      }
+    }
+  }
+  chunks.push_back(bytes.size());
+
+  if (chunks.size() <= 2) {
+    return parsers.front()->parse(bytes, parent);
+  }
+
+  // The parsers of the chunks do not see the keys of the other chunks. We
+  // therefore let the sequential parser report duplicate top level keys.
+  unordered_set<string> names;
+  for (auto key : keys) {
+    if (!names.insert(keyName(bytes, key)).second) {
+      return parsers.front()->parse(bytes, parent);
+    }
+  }
+
+  size_t const workers = chunks.size() - 1;
+  vector<CppKeySet> results(workers);
+  vector<exception_ptr> errors(workers);
+  vector<CppKey> parents;
+  for (size_t worker = 0; worker < workers; worker++) {
+    // Keys use non-atomic reference counts, so every thread needs its own
+    // parent key
+    parents.push_back(CppKey{parent.dup()});
+  }
+
+  vector<thread> threads;
+  for (size_t worker = 0; worker < workers; worker++) {
+    threads.push_back(thread{[&, worker]() {
+      try {
+        results[worker] = parsers[worker]->parse(
+            bytes.substr(chunks[worker], chunks[worker + 1] - chunks[worker]),
+            parents[worker]);
+      } catch (...) {
+        errors[worker] = current_exception();
+      }
+    }});
+  }
+  for (auto &worker : threads) {
+    worker.join();
+  }
+
+  for (auto const &error : errors) {
+    if (error) {
+      // The positions in the error messages of a chunk do not match the
+      // positions in the whole input. We therefore parse the data again to
+      // report the same errors as the sequential parser.
+      return parsers.front()->parse(bytes, parent);
+    }
+  }
+
+  CppKeySet keySet;
+  for (auto const &result : results) {
+    keySet.append(result);
+  }
+  // The parsers only checked the number of keys of their own chunk
+  if (static_cast<size_t>(keySet.size()) > limits.keys) {
+    throw ParseCancellationException("Number of keys exceeds the limit of " +
+                                     to_string(limits.keys));
+  }
+  return keySet;
+}
@@ -0,0 +1,97 @@
+#ifndef YANLR_PARALLEL_PARSER_HPP
+#define YANLR_PARALLEL_PARSER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <memory>
+#include <vector>
+
+#include "Parser.hpp"
+
+using std::unique_ptr;
+using std::vector;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class converts YAML data to key sets using multiple threads.
+ *
+ * If the top level of the data is a block mapping, then every key in the
+ * first column starts an independent subtree. The parser splits the input
+ * before some of these keys and parses the resulting chunks on separate
+ * threads. The merged result is the same as the result of `Parser::parse`.
+ *
+ * For all other input and for invalid input, the class falls back to a
+ * single (sequential) parse. Error messages therefore also stay the same.
+ */
+class ParallelParser {
+  /** This vector stores one parser for every thread. */
+  vector<unique_ptr<Parser>> parsers;
+
+  /** This variable stores the resource limits for a single document. */
+  Limits limits;
+
+public:
+  /**
+   * @brief This constructor creates a new parallel parser.
+   *
+   * @param threads This number specifies the maximum number of threads the
+   *                parser uses.
+   */
+  ParallelParser(size_t const threads);
+
+  /**
+   * @brief This method specifies how the parser handles comments.
+   *
+   * @param mode This parameter specifies the new comment mode.
+   */
+  void setCommentMode(CommentMode const mode);
+
+  /**
+   * @brief This method specifies how `parse` stores the type of scalars.
+   *
+   * @param mode This parameter specifies the new resolution mode.
+   */
+  void setTypeResolution(TypeResolution const mode);
+
+  /**
+   * @brief This method specifies the resource limits for a single document.
+   *
+   * Every chunk has to stay below the limits, and the key limit also applies
+   * to the merged key set.
+   *
+   * @param documentLimits This parameter stores the new limits.
+   */
+  void setLimits(Limits const &documentLimits);
+
+  /**
+   * @brief This function returns the start offsets of all top level keys.
+   *
+   * The function only checks the first line of each top level entry, and it
+   * skips quoted scalars and comments the same way the lexer does.
+   *
+   * @param text This parameter stores YAML data.
+   *
+   * @return The byte offsets of all lines that start with a key in the first
+   *         column or an empty list, if the top level of `text` is not a
+   *         block mapping starting in the first column
+   */
+  static vector<size_t> topLevelKeys(string const &text);
+
+  /**
+   * @brief This method converts the given YAML data to a key set.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param parent This key specifies the parent of all keys stored in the
+   *               returned key set.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data or exceeds one of the limits
+   *
+   * @return A key set that represents the given YAML data
+   */
+  CppKeySet parse(string const &bytes, CppKey const &parent);
+};
+
+#endif // YANLR_PARALLEL_PARSER_HPP
@@ -0,0 +1,402 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "Parser.hpp"
+
+using std::current_exception;
+using std::exception_ptr;
+using std::make_shared;
+using std::rethrow_exception;
+
+using antlr4::CommonTokenFactory;
+using antlr4::ParseCancellationException;
+using antlr4::RuntimeException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new parser.
+ */
+Parser::Parser() {
+  parser.removeErrorListeners();
+  parser.addErrorListener(&errorListener);
+}
+
+/**
+ * @brief This method specifies how the parser handles comments.
+ *
+ * By default the parser ignores comments. If you preserve comments, then
+ * `parse` and `select` attach each comment to the nearest key, using the
+ * metadata `comment/#0`, `comment/#1`, …. Dropping comments is the fastest
+ * option for inputs that contain a lot of comments.
+ *
+ * @param mode This parameter specifies the new comment mode.
+ */
+void Parser::setCommentMode(CommentMode const mode) {
+  commentMode = mode;
+  lexer.setCommentMode(mode);
+}
+
+/**
+ * @brief This method specifies how `parse` and `select` store the type of
+ *        scalars.
+ *
+ * By default the parser stores all scalars as strings.
+ *
+ * @param mode This parameter specifies the new resolution mode.
+ */
+void Parser::setTypeResolution(TypeResolution const mode) {
+  keyListener.setTypeResolution(mode);
+  layerListener.setTypeResolution(mode);
+}
+
+/**
+ * @brief This method specifies the resource limits for a single document.
+ *
+ * Parsing methods throw a `ParseCancellationException`, if a document exceeds
+ * one of the limits. The message of the exception describes the exceeded
+ * limit.
+ *
+ * @param limits This parameter stores the new limits.
+ */
+void Parser::setLimits(Limits const &limits) {
+  lexer.setLimits(limits);
+  keyListener.setLimits(limits);
+  layerListener.setLimits(limits);
+  treeListener.setLimits(limits);
+  jsonListener.setLimits(limits);
+}
+
+/**
+ * @brief This method specifies if the lexer runs on a separate thread.
+ *
+ * In pipelined mode the lexer runs ahead of the grammar parser on a producer
+ * thread, while the grammar parser and the listeners run on the calling
+ * thread. For large inputs the time to parse a document then approaches the
+ * time of the slower stage, instead of the sum of both. The tokens store their
+ * positions right away in this mode, which makes small documents slightly
+ * slower to parse.
+ *
+ * @param enabled This boolean specifies if the parser should use a separate
+ *                thread for the lexer.
+ */
+void Parser::setPipelined(bool const enabled) {
+  pipelined = enabled;
+  // Position tokens compute their location from the line index of the lexer,
+  // which the producer thread keeps modifying
+  lexer.setTokenFactory(enabled ? CommonTokenFactory::DEFAULT
+                                : make_shared<PositionTokenFactory>());
+}
+
+/**
+ * @brief This method runs the lexer and the grammar parser on the given YAML
+ *        data.
+ *
+ * The method stores syntax errors in `errorListener`.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param buffered This boolean specifies if `tokens` keeps all tokens of the
+ *                 data. Otherwise the grammar parser reads the tokens via
+ *                 `unbufferedTokens`, which drops consumed tokens. Only parse
+ *                 listeners can use the tokens then.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If the lexer is unable to split `bytes`
+ *                                    into tokens
+ *
+ * @return The root of the parse tree, which stays valid until the next call of
+ *         this method
+ */
+YAML::YamlContext *Parser::recognize(string bytes, bool const buffered) {
+  errorListener.reset();
+  input = UTF8InputStream{move(bytes)};
+
+  // Resetting the components (instead of recreating them) keeps the
+  // (shared) prediction cache of the grammar parser and all allocated
+  // buffers around for the next input.
+  lexer.reset(&input);
+  TokenSource *source = &lexer;
+  if (pipelined) {
+    pipeline.start(&lexer);
+    source = &pipeline;
+  }
+
+  YAML::YamlContext *tree;
+  try {
+    if (buffered) {
+      tokens.setTokenSource(source);
+      parser.setTokenStream(&tokens);
+    } else {
+      // An unbuffered stream reads its first token right away, so we can not
+      // reuse it for the next input
+      unique_ptr<UnbufferedTokenStream> stream{
+          new UnbufferedTokenStream{source}};
+      parser.setTokenStream(stream.get());
+      unbufferedTokens = move(stream);
+    }
+    tree = parser.yaml();
+  } catch (...) {
+    pipeline.stop();
+    throw;
+  }
+  // The listeners and `keySet` access the lexer afterwards
+  pipeline.stop();
+  return tree;
+}
+
+/**
+ * @brief This method creates a parse tree for the given YAML data.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param buffered This boolean specifies if `tokens` keeps all tokens of the
+ *                 data (see `recognize`).
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML data
+ *
+ * @return The root of the parse tree, which stays valid until the next call of
+ *         this method
+ */
+YAML::YamlContext *Parser::parseTree(string bytes, bool const buffered) {
+  auto tree = recognize(move(bytes), buffered);
+  if (!errorListener.errors().empty()) {
+    string message;
+    for (auto const &error : errorListener.errors()) {
+      message += (message.empty() ? "" : "\n") + error;
+    }
+    throw ParseCancellationException(message);
+  }
+  return tree;
+}
+
+/**
+ * @brief This method converts the parse tree of the last input to a key set.
+ *
+ * @param tree This parameter stores the root of the parse tree.
+ * @param parent This key specifies the parent of all keys stored in the
+ *               returned key set.
+ *
+ * @return A key set that represents the parse tree
+ */
+CppKeySet Parser::keySet(YAML::YamlContext *tree, CppKey const &parent) {
+  keyListener.reset(parent);
+  walk(keyListener, tree);
+  return keyListener.keySet();
+}
+
+/**
+ * @brief This method walks the parse tree of the last input with the given
+ *        key listener.
+ *
+ * @param listener This parameter stores the listener that receives the
+ *                 comments of the last input and the events of the walk.
+ * @param tree This parameter stores the root of the parse tree.
+ */
+void Parser::walk(KeyListener &listener, YAML::YamlContext *tree) {
+  if (commentMode == CommentMode::PRESERVE) {
+    vector<Token *> comments;
+    for (auto token : tokens.getTokens()) {
+      if (token->getType() == YAMLLexer::COMMENT) {
+        comments.push_back(token);
+      }
+    }
+    listener.setComments(move(comments));
+  }
+  walker.walk(&listener, tree);
+}
+
+/**
+ * @brief This method converts the given YAML data to a key set.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param parent This key specifies the parent of all keys stored in the
+ *               returned key set.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML data
+ *
+ * @return A key set that represents the given YAML data
+ */
+CppKeySet Parser::parse(string bytes, CppKey const &parent) {
+  lexer.setSelection(nullptr);
+  return keySet(parseTree(move(bytes)), parent);
+}
+
+/**
+ * @brief This method converts the given YAML data to a key tree.
+ *
+ * Use this method instead of `parse`, if the data contains many keys and you
+ * only need (key sets for) some of them.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param parent This parameter specifies the name of the parent of all keys
+ *               stored in the returned tree.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML data
+ *
+ * @return A key tree that represents the given YAML data, with the children
+ *         of each node ordered by base name
+ */
+KeyTree Parser::parseKeyTree(string bytes, string const &parent) {
+  lexer.setSelection(nullptr);
+  auto tree = parseTree(move(bytes));
+  treeListener.reset(parent);
+  walker.walk(&treeListener, tree);
+  return treeListener.keyTree();
+}
+
+/**
+ * @brief This method converts the requested parts of the given YAML data to a
+ *        key set.
+ *
+ * The lexer skips data that does not belong to the requested keys, and it
+ * stops as soon as it read all of them. The method therefore does not detect
+ * syntax errors in the skipped parts of the input. Aliases of anchors in
+ * skipped parts are unknown.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param parent This key specifies the parent of all keys stored in the
+ *               returned key set.
+ * @param names This parameter stores the names of the requested keys. Each
+ *              name selects the key and all keys below it.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8 or
+ *                                  one of the names is not located below
+ *                                  `parent`
+ * @throws ParseCancellationException If `bytes` does not store valid YAML data
+ *
+ * @return A key set that contains the requested keys
+ */
+CppKeySet Parser::select(string bytes, CppKey const &parent,
+                         vector<string> const &names) {
+  auto selection = make_shared<Selection>(parent, names);
+  lexer.setSelection(selection);
+  return selection->filter(keySet(parseTree(move(bytes)), parent));
+}
+
+/**
+ * @brief This method removes the keys of all layers.
+ *
+ * @param parent This key specifies the parent of all keys stored in the layers
+ *               added afterwards.
+ */
+void Parser::resetLayers(CppKey const &parent) {
+  layerParent = parent;
+  layerListener.reset(parent);
+}
+
+/**
+ * @brief This method applies the given YAML data on top of the layers added
+ *        before.
+ *
+ * Scalars and sequences of the new layer replace the data of earlier layers,
+ * while mappings merge with the mappings of earlier layers. The parser
+ * converts the layer directly into the shared key set of all layers, so apart
+ * from the key set only the data of a single layer is in memory at any time.
+ * The key limit applies to the shared key set. Call `resetLayers` before the
+ * first layer.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML
+ *                                    data. If the error was not a syntax
+ *                                    error, then the layers might contain a
+ *                                    part of the new layer.
+ */
+void Parser::addLayer(string bytes) {
+  lexer.setSelection(nullptr);
+  auto tree = parseTree(move(bytes));
+  layerListener.resetLayer(layerParent);
+  walk(layerListener, tree);
+}
+
+/**
+ * @brief This method returns the result of all layers added so far.
+ *
+ * @return A key set that stores the merged data of all layers
+ */
+CppKeySet Parser::layers() { return layerListener.keySet(); }
+
+/**
+ * @brief This method checks if the given data is valid YAML.
+ *
+ * The method only runs the lexer and the grammar parser. It neither builds a
+ * parse tree nor keys, the lexer drops comments, and the grammar parser
+ * reads the tokens without buffering them. Errors that only the
+ * listeners detect (duplicate keys, unknown aliases and the key limits) are
+ * therefore not part of the result.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ *
+ * @return The messages of all errors in `bytes` or an empty list, if `bytes`
+ *         stores valid YAML data
+ */
+vector<string> Parser::check(string bytes) {
+  lexer.setSelection(nullptr);
+  lexer.setCommentMode(CommentMode::DROP);
+  parser.setBuildParseTree(false);
+
+  vector<string> diagnostics;
+  try {
+    // Without a parse tree nothing refers to consumed tokens
+    recognize(move(bytes), false);
+    diagnostics = errorListener.errors();
+  } catch (RuntimeException const &error) {
+    diagnostics = errorListener.errors();
+    diagnostics.push_back(error.what());
+  }
+
+  parser.setBuildParseTree(true);
+  lexer.setCommentMode(commentMode);
+  return diagnostics;
+}
+
+/**
+ * @brief This method converts the given YAML data to JSON.
+ *
+ * The method writes JSON text while the grammar parser matches the data,
+ * without creating keys. The JSON text keeps the order of mappings. The
+ * listener that writes the text does not detect duplicate keys.
+ *
+ * The token stream drops tokens after the grammar parser consumed them. Since
+ * the grammar parser reports its progress to a listener, it still creates a
+ * rule context for every matched rule and a terminal node for every token.
+ * These objects stay in memory until the next call of a parse method, so the
+ * memory usage of the method grows linearly with the number of tokens in
+ * `bytes`.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param output This parameter specifies the stream that receives the JSON
+ *               text. If the method throws an exception, then the stream might
+ *               contain a part of the text.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML data
+ */
+void Parser::toJSON(string bytes, std::ostream &output) {
+  lexer.setSelection(nullptr);
+  lexer.setCommentMode(CommentMode::DROP);
+  parser.setBuildParseTree(false);
+  jsonListener.reset(output);
+  // As parse listener the JSON listener receives events while the grammar
+  // parser matches tokens
+  parser.addParseListener(&jsonListener);
+
+  exception_ptr error;
+  try {
+    // The listener reads the text of every token, while the grammar parser
+    // matches it. The terminal nodes of consumed tokens refer to tokens the
+    // unbuffered stream already released, so nothing may use them later.
+    parseTree(move(bytes), false);
+  } catch (...) {
+    error = current_exception();
+  }
+
+  parser.removeParseListener(&jsonListener);
+  parser.setBuildParseTree(true);
+  lexer.setCommentMode(commentMode);
+  if (error) {
+    rethrow_exception(error);
+  }
+}
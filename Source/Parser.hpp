@@ -0,0 +1,335 @@
+#ifndef YANLR_PARSER_HPP
+#define YANLR_PARSER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <antlr4-runtime.h>
+#include <kdb.hpp>
+
+#include "YAML.h"
+
+#include "ErrorListener.hpp"
+#include "JSONListener.hpp"
+#include "KeyTree.hpp"
+#include "Listener.hpp"
+#include "TokenPipeline.hpp"
+#include "TreeListener.hpp"
+#include "UTF8InputStream.hpp"
+#include "YAMLLexer.hpp"
+
+using antlr4::CommonTokenStream;
+using antlr4::UnbufferedTokenStream;
+using antlr4::tree::ParseTreeWalker;
+
+using antlr::YAML;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class converts YAML data to key sets.
+ *
+ * A parser keeps its lexer, token stream, grammar parser and listeners alive
+ * between calls to `parse`. Applications that parse many (small) documents
+ * should therefore reuse a single parser object, instead of creating a new
+ * one for every document.
+ */
+class Parser {
+  /** This variable stores the input of the current parsing process. */
+  UTF8InputStream input{""};
+
+  /** This lexer splits `input` into tokens. */
+  YAMLLexer lexer{&input};
+
+  /** This pipeline runs `lexer` on a separate thread in pipelined mode. */
+  TokenPipeline pipeline{};
+
+  /** This variable stores the tokens produced by `lexer`. */
+  CommonTokenStream tokens{&lexer};
+
+  /**
+   * This variable stores the tokens of the current decision of the grammar
+   * parser, while the parser converts data without a parse tree.
+   */
+  unique_ptr<UnbufferedTokenStream> unbufferedTokens;
+
+  /** This parser matches `tokens` against the rules of the YAML grammar. */
+  YAML parser{&tokens};
+
+  /** This listener collects the syntax errors reported by `parser`. */
+  ErrorListener errorListener{};
+
+  /** This listener converts the parse tree to a key set. */
+  KeyListener keyListener{CppKey{}};
+
+  /** This listener applies the parse trees of layers to a single key set. */
+  KeyListener layerListener{CppKey{}};
+
+  /** This key specifies the parent of the keys of all layers. */
+  CppKey layerParent{};
+
+  /** This listener converts the parse tree to a key tree. */
+  TreeListener treeListener{""};
+
+  /** This listener converts the parser events to JSON. */
+  JSONListener jsonListener{};
+
+  /** This walker visits the parse tree produced by `parser`. */
+  ParseTreeWalker walker{};
+
+  /** This variable specifies how the parser handles comments. */
+  CommentMode commentMode = CommentMode::HIDDEN;
+
+  /** This boolean specifies if the lexer runs on a separate thread. */
+  bool pipelined = false;
+
+  /**
+   * @brief This method runs the lexer and the grammar parser on the given
+   *        YAML data.
+   *
+   * The method stores syntax errors in `errorListener`.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param buffered This boolean specifies if `tokens` keeps all tokens of
+   *                 the data. Otherwise the grammar parser reads the tokens
+   *                 via `unbufferedTokens`, which drops consumed tokens. Only
+   *                 parse listeners can use the tokens then.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If the lexer is unable to split
+   *                                    `bytes` into tokens
+   *
+   * @return The root of the parse tree, which stays valid until the next call
+   *         of this method
+   */
+  YAML::YamlContext *recognize(string bytes, bool const buffered = true);
+
+  /**
+   * @brief This method creates a parse tree for the given YAML data.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param buffered This boolean specifies if `tokens` keeps all tokens of
+   *                 the data (see `recognize`).
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data
+   *
+   * @return The root of the parse tree, which stays valid until the next call
+   *         of this method
+   */
+  YAML::YamlContext *parseTree(string bytes, bool const buffered = true);
+
+  /**
+   * @brief This method converts the parse tree of the last input to a key set.
+   *
+   * @param tree This parameter stores the root of the parse tree.
+   * @param parent This key specifies the parent of all keys stored in the
+   *               returned key set.
+   *
+   * @return A key set that represents the parse tree
+   */
+  CppKeySet keySet(YAML::YamlContext *tree, CppKey const &parent);
+
+  /**
+   * @brief This method walks the parse tree of the last input with the given
+   *        key listener.
+   *
+   * @param listener This parameter stores the listener that receives the
+   *                 comments of the last input and the events of the walk.
+   * @param tree This parameter stores the root of the parse tree.
+   */
+  void walk(KeyListener &listener, YAML::YamlContext *tree);
+
+public:
+  /**
+   * @brief This constructor creates a new parser.
+   */
+  Parser();
+
+  /**
+   * @brief This method specifies how the parser handles comments.
+   *
+   * By default the parser ignores comments. If you preserve comments, then
+   * `parse` and `select` attach each comment to the nearest key, using the
+   * metadata `comment/#0`, `comment/#1`, …. Dropping comments is the fastest
+   * option for inputs that contain a lot of comments.
+   *
+   * @param mode This parameter specifies the new comment mode.
+   */
+  void setCommentMode(CommentMode const mode);
+
+  /**
+   * @brief This method specifies how `parse` and `select` store the type of
+   *        scalars.
+   *
+   * By default the parser stores all scalars as strings.
+   *
+   * @param mode This parameter specifies the new resolution mode.
+   */
+  void setTypeResolution(TypeResolution const mode);
+
+  /**
+   * @brief This method specifies the resource limits for a single document.
+   *
+   * Parsing methods throw a `ParseCancellationException`, if a document
+   * exceeds one of the limits. The message of the exception describes the
+   * exceeded limit.
+   *
+   * @param limits This parameter stores the new limits.
+   */
+  void setLimits(Limits const &limits);
+
+  /**
+   * @brief This method specifies if the lexer runs on a separate thread.
+   *
+   * In pipelined mode the lexer runs ahead of the grammar parser on a producer
+   * thread, while the grammar parser and the listeners run on the calling
+   * thread. For large inputs the time to parse a document then approaches the
+   * time of the slower stage, instead of the sum of both. The tokens store
+   * their positions right away in this mode, which makes small documents
+   * slightly slower to parse.
+   *
+   * @param enabled This boolean specifies if the parser should use a separate
+   *                thread for the lexer.
+   */
+  void setPipelined(bool const enabled);
+
+  /**
+   * @brief This method converts the given YAML data to a key set.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param parent This key specifies the parent of all keys stored in the
+   *               returned key set.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data
+   *
+   * @return A key set that represents the given YAML data
+   */
+  CppKeySet parse(string bytes, CppKey const &parent);
+
+  /**
+   * @brief This method converts the given YAML data to a key tree.
+   *
+   * Use this method instead of `parse`, if the data contains many keys and
+   * you only need (key sets for) some of them.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param parent This parameter specifies the name of the parent of all keys
+   *               stored in the returned tree.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data
+   *
+   * @return A key tree that represents the given YAML data, with the
+   *         children of each node ordered by base name
+   */
+  KeyTree parseKeyTree(string bytes, string const &parent);
+
+  /**
+   * @brief This method converts the requested parts of the given YAML data to
+   *        a key set.
+   *
+   * The lexer skips data that does not belong to the requested keys, and it
+   * stops as soon as it read all of them. The method therefore does not
+   * detect syntax errors in the skipped parts of the input. Aliases of
+   * anchors in skipped parts are unknown.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param parent This key specifies the parent of all keys stored in the
+   *               returned key set.
+   * @param names This parameter stores the names of the requested keys. Each
+   *              name selects the key and all keys below it.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8 or
+   *                                  one of the names is not located below
+   *                                  `parent`
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data
+   *
+   * @return A key set that contains the requested keys
+   */
+  CppKeySet select(string bytes, CppKey const &parent,
+                   vector<string> const &names);
+
+  /**
+   * @brief This method removes the keys of all layers.
+   *
+   * @param parent This key specifies the parent of all keys stored in the
+   *               layers added afterwards.
+   */
+  void resetLayers(CppKey const &parent);
+
+  /**
+   * @brief This method applies the given YAML data on top of the layers added
+   *        before.
+   *
+   * Scalars and sequences of the new layer replace the data of earlier
+   * layers, while mappings merge with the mappings of earlier layers. The
+   * parser converts the layer directly into the shared key set of all layers,
+   * so apart from the key set only the data of a single layer is in memory at
+   * any time. The key limit applies to the shared key set. Call
+   * `resetLayers` before the first layer.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data. If the error was not a syntax
+   *                                    error, then the layers might contain a
+   *                                    part of the new layer.
+   */
+  void addLayer(string bytes);
+
+  /**
+   * @brief This method returns the result of all layers added so far.
+   *
+   * @return A key set that stores the merged data of all layers
+   */
+  CppKeySet layers();
+
+  /**
+   * @brief This method checks if the given data is valid YAML.
+   *
+   * The method only runs the lexer and the grammar parser. It neither builds
+   * a parse tree nor keys, the lexer drops comments, and the grammar parser
+   * reads the tokens without buffering them. Errors that only the listeners
+   * detect (duplicate keys, unknown aliases and the key limits) are therefore
+   * not part of the result.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   *
+   * @return The messages of all errors in `bytes` or an empty list, if
+   *         `bytes` stores valid YAML data
+   */
+  vector<string> check(string bytes);
+
+  /**
+   * @brief This method converts the given YAML data to JSON.
+   *
+   * The method writes JSON text while the grammar parser matches the data,
+   * without creating keys. The JSON text keeps the order of mappings. The
+   * listener that writes the text does not detect duplicate keys.
+   *
+   * The token stream drops tokens after the grammar parser consumed them.
+   * Since the grammar parser reports its progress to a listener, it still
+   * creates a rule context for every matched rule and a terminal node for
+   * every token. These objects stay in memory until the next call of a parse
+   * method, so the memory usage of the method grows linearly with the number
+   * of tokens in `bytes`.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param output This parameter specifies the stream that receives the JSON
+   *               text. If the method throws an exception, then the stream
+   *               might contain a part of the text.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data
+   */
+  void toJSON(string bytes, std::ostream &output);
+};
+
+#endif // YANLR_PARSER_HPP
@@ -0,0 +1,120 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "PositionToken.hpp"
+
+using antlr4::CommonTokenFactory;
+using antlr4::Token;
+using antlr4::misc::Interval;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new token.
+ *
+ * @param index This parameter stores the line starts of the token input.
+ * @param source This pair stores the token source and the input of the token.
+ * @param type This parameter specifies the type of the token.
+ * @param start This number specifies the offset of the first byte of the
+ *              token.
+ * @param stop This number specifies the offset of the last byte of the token.
+ */
+PositionToken::PositionToken(shared_ptr<LineIndex const> index,
+                             pair<TokenSource *, CharStream *> source,
+                             size_t type, size_t start, size_t stop)
+    : CommonToken{type}, lines{move(index)} {
+  // The constructor of `CommonToken` that takes a source asks the source for
+  // the current position. We set the properties ourselves to avoid that.
+  _source = source;
+  setChannel(Token::DEFAULT_CHANNEL);
+  setStartIndex(start);
+  setStopIndex(stop);
+}
+
+/**
+ * @brief This method returns the line of the token.
+ *
+ * @return The line number (starting with 1) of the first token character
+ */
+size_t PositionToken::getLine() const { return lines->line(getStartIndex()); }
+
+/**
+ * @brief This method returns the column of the token.
+ *
+ * @return The position (starting with 1) of the first token character in its
+ *         line
+ */
+size_t PositionToken::getCharPositionInLine() const {
+  return lines->column(getStartIndex());
+}
+
+/**
+ * @brief This method returns a textual representation of the token.
+ *
+ * @return A string containing the properties of the token
+ */
+string PositionToken::toString() const {
+  // Copying the token resolves its position
+  CommonToken copy{const_cast<PositionToken *>(this)};
+  return copy.toString();
+}
+
+/**
+ * @brief This constructor creates a new token factory.
+ *
+ * @param copy This boolean specifies if created tokens should store a copy of
+ *             their text. Use this option, if the input drops text it already
+ *             returned.
+ */
+PositionTokenFactory::PositionTokenFactory(bool const copy) : copyText{copy} {}
+
+/**
+ * @brief This method creates a token that determines its position lazily.
+ *
+ * @param lines This parameter stores the line starts of the token input.
+ * @param source This pair stores the token source and the input of the token.
+ * @param type This parameter specifies the type of the token.
+ * @param text This parameter stores the text of the token. If it is empty,
+ *             then the token retrieves its text from the input.
+ * @param start This number specifies the offset of the first byte of the
+ *              token.
+ * @param stop This number specifies the offset of the last byte of the token.
+ *
+ * @return A token with the given properties
+ */
+unique_ptr<CommonToken>
+PositionTokenFactory::create(shared_ptr<LineIndex const> const &lines,
+                             pair<TokenSource *, CharStream *> source,
+                             size_t type, string const &text, size_t start,
+                             size_t stop) {
+  unique_ptr<CommonToken> token{
+      new PositionToken{lines, source, type, start, stop}};
+  if (!text.empty()) {
+    token->setText(text);
+  } else if (copyText && source.second != nullptr) {
+    token->setText(source.second->getText(Interval{start, stop}));
+  }
+  return token;
+}
+
+/**
+ * @brief This method creates a token with a fixed position.
+ *
+ * @return A token with the given properties
+ */
+unique_ptr<CommonToken> PositionTokenFactory::create(
+    pair<TokenSource *, CharStream *> source, size_t type, string const &text,
+    size_t channel, size_t start, size_t stop, size_t line,
+    size_t charPositionInLine) {
+  return CommonTokenFactory{copyText}.create(source, type, text, channel, start,
+                                             stop, line, charPositionInLine);
+}
+
+/**
+ * @brief This method creates a token without a source.
+ *
+ * @return A token with the given type and text
+ */
+unique_ptr<CommonToken> PositionTokenFactory::create(size_t type,
+                                                     string const &text) {
+  return CommonTokenFactory{copyText}.create(type, text);
+}
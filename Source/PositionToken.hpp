@@ -0,0 +1,135 @@
+#ifndef YANLR_POSITION_TOKEN_HPP
+#define YANLR_POSITION_TOKEN_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <memory>
+
+#include <antlr4-runtime.h>
+
+#include "LineIndex.hpp"
+
+using std::pair;
+using std::shared_ptr;
+using std::string;
+using std::unique_ptr;
+
+using antlr4::CharStream;
+using antlr4::CommonToken;
+using antlr4::TokenFactory;
+using antlr4::TokenSource;
+
+// -- Classes ------------------------------------------------------------------
+
+/**
+ * @brief This class represents a token that determines its line and column
+ *        only on request.
+ *
+ * The token only stores byte offsets. Most tokens never need a position, so
+ * the lexer does not have to compute one for every token.
+ */
+class PositionToken : public CommonToken {
+  /** This variable stores the line start offsets of the token input. */
+  shared_ptr<LineIndex const> lines;
+
+public:
+  /**
+   * @brief This constructor creates a new token.
+   *
+   * @param index This parameter stores the line starts of the token input.
+   * @param source This pair stores the token source and the input of the
+   *               token.
+   * @param type This parameter specifies the type of the token.
+   * @param start This number specifies the offset of the first byte of the
+   *              token.
+   * @param stop This number specifies the offset of the last byte of the
+   *             token.
+   */
+  PositionToken(shared_ptr<LineIndex const> index,
+                pair<TokenSource *, CharStream *> source, size_t type,
+                size_t start, size_t stop);
+
+  /**
+   * @brief This method returns the line of the token.
+   *
+   * @return The line number (starting with 1) of the first token character
+   */
+  size_t getLine() const override;
+
+  /**
+   * @brief This method returns the column of the token.
+   *
+   * @return The position (starting with 1) of the first token character in
+   *         its line
+   */
+  size_t getCharPositionInLine() const override;
+
+  /**
+   * @brief This method returns a textual representation of the token.
+   *
+   * @return A string containing the properties of the token
+   */
+  string toString() const override;
+};
+
+/**
+ * @brief This factory creates tokens that determine their position lazily.
+ */
+class PositionTokenFactory : public TokenFactory<CommonToken> {
+  /**
+   * This boolean specifies if tokens store a copy of their text, instead of
+   * retrieving it from the input.
+   */
+  bool const copyText;
+
+public:
+  /**
+   * @brief This constructor creates a new token factory.
+   *
+   * @param copy This boolean specifies if created tokens should store a copy
+   *             of their text. Use this option, if the input drops text it
+   *             already returned.
+   */
+  PositionTokenFactory(bool const copy = false);
+
+  /**
+   * @brief This method creates a token that determines its position lazily.
+   *
+   * @param lines This parameter stores the line starts of the token input.
+   * @param source This pair stores the token source and the input of the
+   *               token.
+   * @param type This parameter specifies the type of the token.
+   * @param text This parameter stores the text of the token. If it is empty,
+   *             then the token retrieves its text from the input.
+   * @param start This number specifies the offset of the first byte of the
+   *              token.
+   * @param stop This number specifies the offset of the last byte of the
+   *             token.
+   *
+   * @return A token with the given properties
+   */
+  unique_ptr<CommonToken> create(shared_ptr<LineIndex const> const &lines,
+                                 pair<TokenSource *, CharStream *> source,
+                                 size_t type, string const &text, size_t start,
+                                 size_t stop);
+
+  /**
+   * @brief This method creates a token with a fixed position.
+   *
+   * @return A token with the given properties
+   */
+  unique_ptr<CommonToken> create(pair<TokenSource *, CharStream *> source,
+                                 size_t type, string const &text,
+                                 size_t channel, size_t start, size_t stop,
+                                 size_t line,
+                                 size_t charPositionInLine) override;
+
+  /**
+   * @brief This method creates a token without a source.
+   *
+   * @return A token with the given type and text
+   */
+  unique_ptr<CommonToken> create(size_t type, string const &text) override;
+};
+
+#endif // YANLR_POSITION_TOKEN_HPP
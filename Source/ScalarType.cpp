@@ -0,0 +1,289 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#include "ScalarType.hpp"
+
+using std::numeric_limits;
+using std::strtod;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function checks if a text matches one of the spellings of a
+ *        YAML keyword.
+ *
+ * The core schema accepts the lower case, capitalized and upper case version
+ * of each keyword. The caller checks `.nan`, which uses different spellings.
+ *
+ * @param text This parameter stores the text this function checks.
+ * @param length This parameter specifies the length of `text`.
+ * @param word This parameter stores the lower case spelling of the keyword.
+ *
+ * @retval true If `text` is a spelling of `word`
+ *         false Otherwise
+ */
+bool isKeyword(char const *text, size_t const length, char const *word) {
+  if (length != strlen(word) || (text[0] | 0x20) != word[0]) {
+    return false;
+  }
+  // The case of the first letter decides the case of the remaining letters
+  bool const upper = length > 1 && text[1] >= 'A' && text[1] <= 'Z';
+  bool const capitalized = text[0] >= 'A' && text[0] <= 'Z';
+  if (upper && !capitalized) {
+    return false;
+  }
+  for (size_t index = 1; index < length; index++) {
+    char const expected = upper ? word[index] - ('a' - 'A') : word[index];
+    if (text[index] != expected) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief This function returns the value of a digit.
+ *
+ * @param character This parameter stores the digit.
+ *
+ * @return The value of `character` or a number larger than 15, if `character`
+ *         is not a (hexadecimal) digit
+ */
+unsigned digitValue(char const character) {
+  if (character >= '0' && character <= '9') {
+    return static_cast<unsigned>(character - '0');
+  }
+  char const lower = character | 0x20;
+  if (lower >= 'a' && lower <= 'f') {
+    return static_cast<unsigned>(lower - 'a' + 10);
+  }
+  return 16;
+}
+
+/**
+ * @brief This function parses an unsigned integer without allocating memory.
+ *
+ * @param start This parameter points to the first digit.
+ * @param end This parameter points behind the last digit.
+ * @param base This parameter specifies the base of the number.
+ * @param limit This parameter specifies the largest allowed value.
+ * @param value This parameter stores the parsed value after the call.
+ *
+ * @retval true If the text between `start` and `end` contains at least one
+ *              digit, only digits of `base` and a number not larger than
+ *              `limit`
+ *         false Otherwise
+ */
+bool parseUnsigned(char const *start, char const *end, unsigned const base,
+                   uint64_t const limit, uint64_t &value) {
+  if (start == end) {
+    return false;
+  }
+  value = 0;
+  for (char const *position = start; position < end; position++) {
+    unsigned const digit = digitValue(*position);
+    if (digit >= base || value > (limit - digit) / base) {
+      return false;
+    }
+    value = value * base + digit;
+  }
+  return true;
+}
+
+/**
+ * @brief This function counts the decimal digits at the given position.
+ *
+ * @param position This parameter points to the first checked character. After
+ *                 the call it points behind the last digit.
+ * @param end This parameter points behind the last character of the text.
+ *
+ * @return The number of digits starting at `position`
+ */
+size_t skipDigits(char const *&position, char const *end) {
+  char const *start = position;
+  while (position < end && *position >= '0' && *position <= '9') {
+    position++;
+  }
+  return static_cast<size_t>(position - start);
+}
+
+/**
+ * @brief This function determines the type of a scalar that starts like a
+ *        number.
+ *
+ * @param text This parameter stores the text of the scalar.
+ *
+ * @return The type and value of `text`
+ */
+ResolvedScalar resolveNumber(string const &text) {
+  ResolvedScalar result;
+  char const *const begin = text.c_str();
+  char const *const end = begin + text.size();
+  char const *position = begin;
+
+  bool const negative = *position == '-';
+  if (*position == '-' || *position == '+') {
+    position++;
+  }
+
+  if (*position == '.' && isKeyword(position + 1, end - position - 1, "inf")) {
+    result.type = ScalarType::FLOAT;
+    result.floating = negative ? -numeric_limits<double>::infinity()
+                               : numeric_limits<double>::infinity();
+    return result;
+  }
+
+  // Hexadecimal and octal numbers do not have a sign in the core schema
+  if (position == begin && text.size() > 2 && begin[0] == '0' &&
+      (begin[1] == 'x' || begin[1] == 'o')) {
+    uint64_t value;
+    if (parseUnsigned(begin + 2, end, begin[1] == 'x' ? 16 : 8,
+                      numeric_limits<int64_t>::max(), value)) {
+      result.type = ScalarType::INTEGER;
+      result.integer = static_cast<int64_t>(value);
+    }
+    return result;
+  }
+
+  char const *const digits = position;
+  size_t const integerDigits = skipDigits(position, end);
+  char const *const digitsEnd = position;
+  bool isFloat = false;
+  if (position < end && *position == '.') {
+    isFloat = true;
+    position++;
+    if (skipDigits(position, end) == 0 && integerDigits == 0) {
+      return result;
+    }
+  } else if (integerDigits == 0) {
+    return result;
+  }
+  if (position < end && (*position == 'e' || *position == 'E')) {
+    isFloat = true;
+    position++;
+    if (position < end && (*position == '-' || *position == '+')) {
+      position++;
+    }
+    if (skipDigits(position, end) == 0) {
+      return result;
+    }
+  }
+  if (position != end) {
+    return result;
+  }
+
+  if (!isFloat) {
+    uint64_t value;
+    uint64_t const limit =
+        static_cast<uint64_t>(numeric_limits<int64_t>::max()) +
+        (negative ? 1 : 0);
+    if (parseUnsigned(digits, digitsEnd, 10, limit, value)) {
+      result.type = ScalarType::INTEGER;
+      // We avoid the (unsigned) overflow of `-value` for the smallest integer
+      result.integer = negative && value > 0
+                           ? -static_cast<int64_t>(value - 1) - 1
+                           : static_cast<int64_t>(value);
+      return result;
+    }
+  }
+
+  // We already checked the syntax, so `strtod` only computes the value
+  result.type = ScalarType::FLOAT;
+  result.floating = strtod(begin, nullptr);
+  return result;
+}
+
+} // namespace
+
+/**
+ * @brief This function determines the type of a plain scalar.
+ *
+ * The function uses the rules of the YAML 1.2 core schema. Integers can use
+ * decimal, hexadecimal (`0x`) or octal (`0o`) notation. Integers that do not
+ * fit into 64 bit are strings (hexadecimal, octal) or floats (decimal).
+ *
+ * @param text This parameter stores the text of a plain scalar.
+ *
+ * @return The type and value of `text`
+ */
+ResolvedScalar resolveScalar(string const &text) {
+  ResolvedScalar result;
+  char const *const data = text.c_str();
+  size_t const length = text.size();
+
+  // The first character rules out most strings, before we look at the rest
+  // of the scalar
+  switch (length == 0 ? '~' : data[0]) {
+  case '~':
+    if (length <= 1) {
+      result.type = ScalarType::NULL_VALUE;
+    }
+    break;
+  case 'n':
+  case 'N':
+    if (isKeyword(data, length, "null")) {
+      result.type = ScalarType::NULL_VALUE;
+    }
+    break;
+  case 't':
+  case 'T':
+  case 'f':
+  case 'F':
+    if (isKeyword(data, length, "true") || isKeyword(data, length, "false")) {
+      result.type = ScalarType::BOOLEAN;
+      result.boolean = (data[0] | 0x20) == 't';
+    }
+    break;
+  case '.':
+    // The core schema only accepts these spellings (and not `.Nan`)
+    if (text == ".nan" || text == ".NaN" || text == ".NAN") {
+      result.type = ScalarType::FLOAT;
+      result.floating = numeric_limits<double>::quiet_NaN();
+      break;
+    }
+    return resolveNumber(text);
+  case '-':
+  case '+':
+  case '0':
+  case '1':
+  case '2':
+  case '3':
+  case '4':
+  case '5':
+  case '6':
+  case '7':
+  case '8':
+  case '9':
+    return resolveNumber(text);
+  default:
+    break;
+  }
+  return result;
+}
+
+/**
+ * @brief This function returns the name Elektra uses for a scalar type.
+ *
+ * @param type This parameter specifies a scalar type.
+ *
+ * @return The value of the `type` metadata for scalars of type `type`
+ */
+char const *typeName(ScalarType const type) {
+  switch (type) {
+  case ScalarType::BOOLEAN:
+    return "boolean";
+  case ScalarType::INTEGER:
+    return "long_long";
+  case ScalarType::FLOAT:
+    return "double";
+  case ScalarType::NULL_VALUE:
+  case ScalarType::STRING:
+    break;
+  }
+  return "string";
+}
@@ -0,0 +1,71 @@
+#ifndef YANLR_SCALAR_TYPE_HPP
+#define YANLR_SCALAR_TYPE_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdint>
+#include <string>
+
+using std::string;
+
+// -- Types --------------------------------------------------------------------
+
+/** This enumeration specifies the types of plain scalars. */
+enum class ScalarType { STRING, NULL_VALUE, BOOLEAN, INTEGER, FLOAT };
+
+/** This enumeration specifies how listeners store the type of scalars. */
+enum class TypeResolution {
+  /** Listeners store all scalars as strings. */
+  NONE,
+  /**
+   * Listeners store the type of plain scalars as `type` metadata and keep
+   * the text of the scalar as value.
+   */
+  METADATA,
+  /**
+   * Listeners store the type of plain scalars as `type` metadata and the
+   * parsed value (`bool`, `int64_t` or `double`) as binary value.
+   */
+  BINARY
+};
+
+/** This structure stores a scalar type together with the parsed value. */
+struct ResolvedScalar {
+  /** This variable stores the type of the scalar. */
+  ScalarType type = ScalarType::STRING;
+
+  /** This variable stores the value of a scalar of type `BOOLEAN`. */
+  bool boolean = false;
+
+  /** This variable stores the value of a scalar of type `INTEGER`. */
+  int64_t integer = 0;
+
+  /** This variable stores the value of a scalar of type `FLOAT`. */
+  double floating = 0;
+};
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function determines the type of a plain scalar.
+ *
+ * The function uses the rules of the YAML 1.2 core schema. Integers can use
+ * decimal, hexadecimal (`0x`) or octal (`0o`) notation. Integers that do not
+ * fit into 64 bit are strings (hexadecimal, octal) or floats (decimal).
+ *
+ * @param text This parameter stores the text of a plain scalar.
+ *
+ * @return The type and value of `text`
+ */
+ResolvedScalar resolveScalar(string const &text);
+
+/**
+ * @brief This function returns the name Elektra uses for a scalar type.
+ *
+ * @param type This parameter specifies a scalar type.
+ *
+ * @return The value of the `type` metadata for scalars of type `type`
+ */
+char const *typeName(ScalarType const type);
+
+#endif // YANLR_SCALAR_TYPE_HPP
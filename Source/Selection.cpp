@@ -0,0 +1,188 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+
+#include <antlr4-runtime.h>
+
+#include "Conversion.hpp"
+#include "Selection.hpp"
+
+using std::min;
+using std::move;
+
+using antlr4::IllegalArgumentException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new selection.
+ *
+ * @param parent This key specifies the parent of the parsed data.
+ * @param names This parameter stores the names of the requested keys. Each
+ *              name selects the key and all keys below it.
+ *
+ * @throws IllegalArgumentException If one of the names is not located at or
+ *                                  below `parent`
+ */
+Selection::Selection(CppKey const &parent, vector<string> const &names) {
+  string const prefix = parent.getName();
+  for (auto const &name : names) {
+    CppKey key{name, KEY_END};
+    if (!key.isBelowOrSame(parent)) {
+      throw IllegalArgumentException("The key “" + name +
+                                     "” is not located below “" + prefix +
+                                     "”");
+    }
+    requests.push_back(key);
+    paths.push_back(splitKeyName(key.getName().substr(prefix.size())));
+  }
+  reset();
+}
+
+/**
+ * @brief This method resets the selection, so it can track a new input.
+ */
+void Selection::reset() {
+  resolved = vector<bool>(paths.size(), false);
+  matched = vector<size_t>(paths.size(), 0);
+  unresolved = paths.size();
+  levels.clear();
+  nextIndex = 0;
+}
+
+/**
+ * @brief This method adds a level to the current key name.
+ *
+ * @param level This parameter stores the added level.
+ */
+void Selection::push(Level level) {
+  size_t const depth = levels.size();
+  for (size_t path = 0; path < paths.size(); path++) {
+    if (matched[path] == depth && depth < paths[path].size() &&
+        paths[path][depth] == level.baseName) {
+      matched[path]++;
+    }
+  }
+  levels.push_back(move(level));
+}
+
+/**
+ * @brief This method removes the top level of the current key name.
+ *
+ * Afterwards all requested keys at or below the removed node are resolved,
+ * since the lexer can not visit the node again.
+ */
+void Selection::pop() {
+  size_t const depth = levels.size();
+  for (size_t path = 0; path < paths.size(); path++) {
+    // The current key name is a prefix of the requested key
+    if (!resolved[path] && matched[path] == depth) {
+      resolved[path] = true;
+      unresolved--;
+    }
+    if (matched[path] == depth) {
+      matched[path]--;
+    }
+  }
+  levels.pop_back();
+}
+
+/**
+ * @brief This method checks if the current node might contain requested data.
+ *
+ * @retval true If the current node is (part of) a requested key or it is
+ *              located below a requested key
+ *         false Otherwise
+ */
+bool Selection::relevant() const {
+  size_t const depth = levels.size();
+  for (size_t path = 0; path < paths.size(); path++) {
+    // Either name is a prefix of the other one
+    if (!resolved[path] &&
+        matched[path] == min(depth, paths[path].size())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief This method removes the levels the lexer left, before it scans a
+ *        token.
+ *
+ * @param column This number specifies the column of the next token.
+ * @param element This boolean specifies if the next token starts a sequence
+ *                element.
+ */
+void Selection::leave(size_t const column, bool const element) {
+  nextIndex = 0;
+  while (!levels.empty() && levels.back().column > column) {
+    pop();
+  }
+
+  // A key or element in the same column replaces the current level
+  if (!levels.empty() && levels.back().column == column) {
+    if (element && levels.back().element) {
+      nextIndex = levels.back().index < UINTMAX_MAX ? levels.back().index + 1
+                                                    : UINTMAX_MAX;
+    }
+    pop();
+  }
+}
+
+/**
+ * @brief This method adds a key to the current key name.
+ *
+ * @param column This number specifies the column of the key.
+ * @param baseName This parameter stores the (unescaped) text of the key.
+ *
+ * @retval true If the value of the key might contain requested data
+ *         false If the lexer can skip the value of the key
+ */
+bool Selection::enterKey(size_t const column, string const &baseName) {
+  push(Level{column, baseName, false, 0});
+  return relevant();
+}
+
+/**
+ * @brief This method adds a sequence element to the current key name.
+ *
+ * @param column This number specifies the column of the element.
+ *
+ * @retval true If the element might contain requested data
+ *         false If the lexer can skip the element
+ */
+bool Selection::enterElement(size_t const column) {
+  push(Level{column, indexToArrayBaseName(nextIndex), true, nextIndex});
+  nextIndex = 0;
+  return relevant();
+}
+
+/**
+ * @brief This method checks if the lexer already read all requested data.
+ *
+ * @retval true If the lexer can stop scanning the input
+ *         false Otherwise
+ */
+bool Selection::done() const { return unresolved == 0; }
+
+/**
+ * @brief This method removes all keys that were not requested.
+ *
+ * @param keys This parameter stores the keys this method filters.
+ *
+ * @return A key set containing the keys of `keys` that are located at or below
+ *         a requested key
+ */
+CppKeySet Selection::filter(CppKeySet const &keys) const {
+  CppKeySet selected;
+  for (auto const &key : keys) {
+    for (auto const &requested : requests) {
+      if (key.isBelowOrSame(requested)) {
+        selected.append(key);
+        break;
+      }
+    }
+  }
+  return selected;
+}
@@ -0,0 +1,158 @@
+#ifndef YANLR_SELECTION_HPP
+#define YANLR_SELECTION_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdint>
+#include <vector>
+
+#include <kdb.hpp>
+
+using std::string;
+using std::vector;
+
+using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class stores the key names requested by a selective parse and
+ *        tracks the position of the lexer relative to these names.
+ *
+ * The lexer reports every key and sequence element it finds together with its
+ * column. The selection uses the columns to determine the name of the current
+ * node. It then tells the lexer if the node can contain requested data. If it
+ * can not, the lexer skips the node without creating tokens for it.
+ */
+class Selection {
+  /** This structure stores a single level of the current key name. */
+  struct Level {
+    /** This number stores the column of the key or sequence element. */
+    size_t column;
+    /** This variable stores the (unescaped) base name of the level. */
+    string baseName;
+    /** This boolean specifies if the level belongs to a sequence element. */
+    bool element;
+    /** This number stores the array index of a sequence element. */
+    uintmax_t index;
+  };
+
+  /** This vector stores the requested keys. */
+  vector<CppKey> requests;
+
+  /** This vector stores the base names of each requested key below parent. */
+  vector<vector<string>> paths;
+
+  /** This vector specifies which requested keys the lexer already read. */
+  vector<bool> resolved;
+
+  /**
+   * This vector stores for each requested key the number of leading levels
+   * of the current key name that match the base names of the requested key.
+   */
+  vector<size_t> matched;
+
+  /** This number stores the number of requested keys not resolved yet. */
+  size_t unresolved;
+
+  /** This stack stores the base names of the current node. */
+  vector<Level> levels;
+
+  /** This number stores the index for the next element of a sequence. */
+  uintmax_t nextIndex = 0;
+
+  /**
+   * @brief This method adds a level to the current key name.
+   *
+   * @param level This parameter stores the added level.
+   */
+  void push(Level level);
+
+  /**
+   * @brief This method removes the top level of the current key name.
+   *
+   * Afterwards all requested keys at or below the removed node are resolved,
+   * since the lexer can not visit the node again.
+   */
+  void pop();
+
+  /**
+   * @brief This method checks if the current node might contain requested
+   *        data.
+   *
+   * @retval true If the current node is (part of) a requested key or it is
+   *              located below a requested key
+   *         false Otherwise
+   */
+  bool relevant() const;
+
+public:
+  /**
+   * @brief This constructor creates a new selection.
+   *
+   * @param parent This key specifies the parent of the parsed data.
+   * @param names This parameter stores the names of the requested keys. Each
+   *              name selects the key and all keys below it.
+   *
+   * @throws IllegalArgumentException If one of the names is not located at or
+   *                                  below `parent`
+   */
+  Selection(CppKey const &parent, vector<string> const &names);
+
+  /**
+   * @brief This method resets the selection, so it can track a new input.
+   */
+  void reset();
+
+  /**
+   * @brief This method removes the levels the lexer left, before it scans a
+   *        token.
+   *
+   * @param column This number specifies the column of the next token.
+   * @param element This boolean specifies if the next token starts a sequence
+   *                element.
+   */
+  void leave(size_t const column, bool const element);
+
+  /**
+   * @brief This method adds a key to the current key name.
+   *
+   * @param column This number specifies the column of the key.
+   * @param baseName This parameter stores the (unescaped) text of the key.
+   *
+   * @retval true If the value of the key might contain requested data
+   *         false If the lexer can skip the value of the key
+   */
+  bool enterKey(size_t const column, string const &baseName);
+
+  /**
+   * @brief This method adds a sequence element to the current key name.
+   *
+   * @param column This number specifies the column of the element.
+   *
+   * @retval true If the element might contain requested data
+   *         false If the lexer can skip the element
+   */
+  bool enterElement(size_t const column);
+
+  /**
+   * @brief This method checks if the lexer already read all requested data.
+   *
+   * @retval true If the lexer can stop scanning the input
+   *         false Otherwise
+   */
+  bool done() const;
+
+  /**
+   * @brief This method removes all keys that were not requested.
+   *
+   * @param keys This parameter stores the keys this method filters.
+   *
+   * @return A key set containing the keys of `keys` that are located at or
+   *         below a requested key
+   */
+  CppKeySet filter(CppKeySet const &keys) const;
+};
+
+#endif // YANLR_SELECTION_HPP
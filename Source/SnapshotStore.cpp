@@ -0,0 +1,303 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdlib>
+#include <new>
+
+#include "SnapshotStore.hpp"
+
+using std::bad_alloc;
+using std::lock_guard;
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+using std::move;
+
+using antlr4::IllegalStateException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a view of a tree.
+ *
+ * @param readerSlot This parameter stores the slot of the reader, which
+ *                   already announced the current epoch.
+ * @param snapshot This parameter stores the tree of the view.
+ */
+SnapshotStore::View::View(Slot *readerSlot, KeyTree const *snapshot)
+    : slot{readerSlot}, tree{snapshot} {}
+
+/**
+ * @brief This constructor takes over the tree of another view.
+ *
+ * @param other This parameter stores the view, which this view replaces.
+ */
+SnapshotStore::View::View(View &&other) : slot{other.slot}, tree{other.tree} {
+  other.slot = nullptr;
+}
+
+/**
+ * @brief This destructor tells the store that the reader does not use the
+ *        tree anymore.
+ */
+SnapshotStore::View::~View() {
+  if (slot) {
+    // The release store orders all reads of the tree before a writer, which
+    // sees the empty slot, deletes the tree
+    slot->epoch.store(0, memory_order_release);
+  }
+}
+
+/**
+ * @brief This method returns the tree of this view.
+ *
+ * @return A tree that stays valid while the view exists
+ */
+KeyTree const &SnapshotStore::View::operator*() const { return *tree; }
+
+/**
+ * @brief This method returns the tree of this view.
+ *
+ * @return A tree that stays valid while the view exists
+ */
+KeyTree const *SnapshotStore::View::operator->() const { return tree; }
+
+/**
+ * @brief This constructor creates a reader that owns the given slot.
+ *
+ * @param owner This parameter stores the store the reader reads from.
+ * @param readerSlot This parameter stores an unused slot of `owner`.
+ */
+SnapshotStore::Reader::Reader(SnapshotStore *owner, Slot *readerSlot)
+    : store{owner}, slot{readerSlot} {}
+
+/**
+ * @brief This constructor takes over the slot of another reader.
+ *
+ * @param other This parameter stores the reader, which this reader replaces.
+ */
+SnapshotStore::Reader::Reader(Reader &&other)
+    : store{other.store}, slot{other.slot} {
+  other.slot = nullptr;
+}
+
+/**
+ * @brief This destructor releases the slot of the reader.
+ */
+SnapshotStore::Reader::~Reader() {
+  if (slot) {
+    slot->used.store(false, memory_order_release);
+  }
+}
+
+/**
+ * @brief This method returns a view of the current tree.
+ *
+ * @return A view that keeps the current tree alive while it exists
+ */
+SnapshotStore::View SnapshotStore::Reader::view() {
+  // The announcement has to be visible before we load the tree. Otherwise a
+  // writer could miss it, and delete the tree we are about to use.
+  slot->epoch.store(store->epoch.load());
+  return View{slot, store->current.load()};
+}
+
+/**
+ * @brief This method retrieves the value of a key in the current tree.
+ *
+ * @param name This parameter stores the name of the key.
+ * @param value This parameter stores the value of the key after the call, if
+ *              the key exists.
+ *
+ * @retval true If the current tree contains the key
+ *         false Otherwise
+ */
+bool SnapshotStore::Reader::lookup(string const &name, string &value) {
+  View const snapshot = view();
+  KeyTree::Node const node = snapshot->lookup(name);
+  if (node == KeyTree::NONE || !snapshot->isKey(node)) {
+    return false;
+  }
+  value = snapshot->value(node);
+  return true;
+}
+
+/**
+ * @brief This constructor creates a store for the given YAML data.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ * @param parentName This parameter specifies the name of the parent of all
+ *                   keys stored in the trees of the store.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML
+ *                                    data
+ */
+SnapshotStore::SnapshotStore(string bytes, string parentName)
+    : parent{move(parentName)} {
+  current.store(new KeyTree{parser.parseKeyTree(move(bytes), parent)});
+}
+
+/**
+ * @brief This destructor deletes all trees.
+ *
+ * All readers have to be destroyed before the store.
+ */
+SnapshotStore::~SnapshotStore() {
+  for (auto const &tree : retired) {
+    delete tree.first;
+  }
+  delete current.load();
+}
+
+/**
+ * @brief This method specifies the resource limits for reloaded data.
+ *
+ * @param limits This parameter stores the new limits.
+ */
+void SnapshotStore::setLimits(Limits const &limits) {
+  lock_guard<mutex> lock{writer};
+  parser.setLimits(limits);
+}
+
+/**
+ * @brief This method replaces the current tree with a tree for the given YAML
+ *        data.
+ *
+ * Readers see the old tree until the method publishes the new one. If the
+ * data is invalid, then readers keep seeing the old tree.
+ *
+ * @param bytes This parameter stores UTF-8 encoded YAML data.
+ *
+ * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+ * @throws ParseCancellationException If `bytes` does not store valid YAML
+ *                                    data
+ */
+void SnapshotStore::reload(string bytes) {
+  lock_guard<mutex> lock{writer};
+  replace(new KeyTree{parser.parseKeyTree(move(bytes), parent)});
+}
+
+/**
+ * @brief This method replaces the current tree.
+ *
+ * @param tree This parameter stores the new tree.
+ */
+void SnapshotStore::publish(KeyTree tree) {
+  unique_ptr<KeyTree const> snapshot{new KeyTree{move(tree)}};
+  lock_guard<mutex> lock{writer};
+  replace(snapshot.release());
+}
+
+/**
+ * @brief This method registers a new reader.
+ *
+ * @throws IllegalStateException If the store already has the maximum number
+ *                               of readers
+ *
+ * @return A reader that owns an unused slot of this store
+ */
+SnapshotStore::Reader SnapshotStore::reader() {
+  for (size_t index = 0; index < SLOTS; index++) {
+    bool unused = false;
+    if (slots[index].used.compare_exchange_strong(unused, true,
+                                                  memory_order_acquire)) {
+      slots[index].epoch.store(0, memory_order_relaxed);
+      return Reader{this, &slots[index]};
+    }
+  }
+  throw IllegalStateException("Unable to register more than " +
+                              std::to_string(SLOTS) + " readers");
+}
+
+/**
+ * @brief This method deletes all retired trees no reader can still use.
+ *
+ * Reloads already delete retired trees. Call this method to release the memory
+ * of the last replaced tree without waiting for the next reload.
+ *
+ * @return The number of retired trees, which readers might still use
+ */
+size_t SnapshotStore::reclaim() {
+  lock_guard<mutex> lock{writer};
+  collect();
+  return retired.size();
+}
+
+// ===========
+// = Private =
+// ===========
+
+/**
+ * @brief This method publishes a new tree and retires the current one.
+ *
+ * The caller has to hold the lock `writer`.
+ *
+ * @param tree This parameter stores the new tree, which the store owns
+ *             afterwards.
+ */
+void SnapshotStore::replace(KeyTree const *tree) {
+  KeyTree const *old = current.exchange(tree);
+  // Readers that announce a later epoch load the new tree
+  retired.emplace_back(old, epoch.fetch_add(1));
+  collect();
+}
+
+/**
+ * @brief This method deletes all retired trees no reader can still use.
+ *
+ * The caller has to hold the lock `writer`.
+ */
+void SnapshotStore::collect() {
+  uint64_t oldest = UINT64_MAX;
+  for (size_t index = 0; index < SLOTS; index++) {
+    uint64_t const announced = slots[index].epoch.load();
+    if (announced != 0 && announced < oldest) {
+      oldest = announced;
+    }
+  }
+
+  // A reader that announced epoch `e` might use every tree retired at an
+  // epoch of at least `e`
+  size_t kept = 0;
+  for (auto const &tree : retired) {
+    if (tree.second < oldest) {
+      delete tree.first;
+    } else {
+      retired[kept++] = tree;
+    }
+  }
+  retired.resize(kept);
+}
+
+/**
+ * @brief This function creates `SLOTS` slots aligned to a cache line.
+ *
+ * @throws bad_alloc If there is not enough memory for the slots
+ *
+ * @return The first slot of the new slots
+ */
+SnapshotStore::Slot *SnapshotStore::allocateSlots() {
+  // Before C++17 `new` ignores alignments larger than the alignment of
+  // `max_align_t`
+  void *memory;
+  if (posix_memalign(&memory, alignof(Slot), SLOTS * sizeof(Slot)) != 0) {
+    throw bad_alloc{};
+  }
+  Slot *first = static_cast<Slot *>(memory);
+  for (size_t index = 0; index < SLOTS; index++) {
+    new (first + index) Slot{};
+  }
+  return first;
+}
+
+/**
+ * @brief This method destroys the given slots and releases their memory.
+ *
+ * @param memory This parameter stores the first of `SLOTS` slots.
+ */
+void SnapshotStore::SlotDeleter::operator()(Slot *memory) const {
+  for (size_t index = 0; index < SLOTS; index++) {
+    memory[index].~Slot();
+  }
+  free(memory);
+}
@@ -0,0 +1,303 @@
+#ifndef YANLR_SNAPSHOT_STORE_HPP
+#define YANLR_SNAPSHOT_STORE_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include "KeyTree.hpp"
+#include "Parser.hpp"
+
+using std::atomic;
+using std::mutex;
+using std::pair;
+using std::unique_ptr;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class publishes immutable key trees, which many threads read
+ *        while another thread replaces them.
+ *
+ * Each reading thread registers a `Reader`, which owns a slot on a separate
+ * cache line. To read the current tree, the reader announces the current
+ * epoch in its slot, and then loads the pointer to the tree. Readers
+ * therefore never take a lock and never write memory shared with other
+ * readers.
+ *
+ * A reload parses the new data outside of any reader path, swaps the pointer
+ * atomically and advances the epoch. The old tree waits in a list of retired
+ * trees until no slot announces an epoch that is not newer than the epoch of
+ * the swap. Only writers scan the slots, so the cost of reclaiming trees does
+ * not affect readers.
+ */
+class SnapshotStore {
+  /** This number specifies the size of a cache line in bytes. */
+  static size_t const CACHE_LINE = 64;
+
+  /** This number specifies the maximum number of registered readers. */
+  static size_t const SLOTS = 64;
+
+  /**
+   * This structure stores the state of a single reader. Each slot occupies
+   * its own cache line.
+   */
+  struct alignas(CACHE_LINE) Slot {
+    /**
+     * This variable stores the epoch the reader announced, before it loaded
+     * the current tree, or `0` if the reader does not use a tree.
+     */
+    atomic<uint64_t> epoch{0};
+    /** This boolean specifies if a reader owns this slot. */
+    atomic<bool> used{false};
+  };
+
+  /** This structure releases the slots created by `allocateSlots`. */
+  struct SlotDeleter {
+    /**
+     * @brief This method destroys the given slots and releases their memory.
+     *
+     * @param memory This parameter stores the first of `SLOTS` slots.
+     */
+    void operator()(Slot *memory) const;
+  };
+
+  /** This array stores the slots of all readers. */
+  unique_ptr<Slot[], SlotDeleter> slots{allocateSlots()};
+
+  /** This variable stores the tree readers see. */
+  atomic<KeyTree const *> current{nullptr};
+
+  /** This counter stores the current epoch. Each reload advances it. */
+  atomic<uint64_t> epoch{1};
+
+  /** This mutex serializes reloads. Readers never use it. */
+  mutex writer;
+
+  /** This parser converts new data to key trees. */
+  Parser parser{};
+
+  /** This variable stores the name of the parent key of all trees. */
+  string parent;
+
+  /**
+   * This list stores replaced trees together with the epoch at the time of
+   * the replacement.
+   */
+  vector<pair<KeyTree const *, uint64_t>> retired;
+
+  /**
+   * @brief This method publishes a new tree and retires the current one.
+   *
+   * The caller has to hold the lock `writer`.
+   *
+   * @param tree This parameter stores the new tree, which the store owns
+   *             afterwards.
+   */
+  void replace(KeyTree const *tree);
+
+  /**
+   * @brief This method deletes all retired trees no reader can still use.
+   *
+   * The caller has to hold the lock `writer`.
+   */
+  void collect();
+
+  /**
+   * @brief This function creates `SLOTS` slots aligned to a cache line.
+   *
+   * @throws bad_alloc If there is not enough memory for the slots
+   *
+   * @return The first slot of the new slots
+   */
+  static Slot *allocateSlots();
+
+public:
+  /**
+   * @brief This class stores a tree, which stays valid while the object
+   *        exists.
+   */
+  class View {
+    friend class SnapshotStore;
+
+    /** This variable stores the slot that announces the use of `tree`. */
+    Slot *slot;
+
+    /** This variable stores the tree of this view. */
+    KeyTree const *tree;
+
+    /**
+     * @brief This constructor creates a view of a tree.
+     *
+     * @param readerSlot This parameter stores the slot of the reader, which
+     *                   already announced the current epoch.
+     * @param snapshot This parameter stores the tree of the view.
+     */
+    View(Slot *readerSlot, KeyTree const *snapshot);
+
+  public:
+    View(View const &) = delete;
+    View &operator=(View const &) = delete;
+
+    /**
+     * @brief This constructor takes over the tree of another view.
+     *
+     * @param other This parameter stores the view, which this view replaces.
+     */
+    View(View &&other);
+
+    /**
+     * @brief This destructor tells the store that the reader does not use
+     *        the tree anymore.
+     */
+    ~View();
+
+    /**
+     * @brief This method returns the tree of this view.
+     *
+     * @return A tree that stays valid while the view exists
+     */
+    KeyTree const &operator*() const;
+
+    /**
+     * @brief This method returns the tree of this view.
+     *
+     * @return A tree that stays valid while the view exists
+     */
+    KeyTree const *operator->() const;
+  };
+
+  /**
+   * @brief This class reads trees of a store on a single thread.
+   *
+   * A reader supports only one view at a time. Use a reader only on one
+   * thread at a time, and destroy all readers before the store.
+   */
+  class Reader {
+    friend class SnapshotStore;
+
+    /** This variable stores the store this reader reads from. */
+    SnapshotStore *store;
+
+    /** This variable stores the slot this reader owns. */
+    Slot *slot;
+
+    /**
+     * @brief This constructor creates a reader that owns the given slot.
+     *
+     * @param owner This parameter stores the store the reader reads from.
+     * @param readerSlot This parameter stores an unused slot of `owner`.
+     */
+    Reader(SnapshotStore *owner, Slot *readerSlot);
+
+  public:
+    Reader(Reader const &) = delete;
+    Reader &operator=(Reader const &) = delete;
+
+    /**
+     * @brief This constructor takes over the slot of another reader.
+     *
+     * @param other This parameter stores the reader, which this reader
+     *              replaces.
+     */
+    Reader(Reader &&other);
+
+    /**
+     * @brief This destructor releases the slot of the reader.
+     */
+    ~Reader();
+
+    /**
+     * @brief This method returns a view of the current tree.
+     *
+     * @return A view that keeps the current tree alive while it exists
+     */
+    View view();
+
+    /**
+     * @brief This method retrieves the value of a key in the current tree.
+     *
+     * @param name This parameter stores the name of the key.
+     * @param value This parameter stores the value of the key after the call,
+     *              if the key exists.
+     *
+     * @retval true If the current tree contains the key
+     *         false Otherwise
+     */
+    bool lookup(string const &name, string &value);
+  };
+
+  /**
+   * @brief This constructor creates a store for the given YAML data.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   * @param parentName This parameter specifies the name of the parent of all
+   *                   keys stored in the trees of the store.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data
+   */
+  SnapshotStore(string bytes, string parentName);
+
+  /**
+   * @brief This destructor deletes all trees.
+   *
+   * All readers have to be destroyed before the store.
+   */
+  ~SnapshotStore();
+
+  /**
+   * @brief This method specifies the resource limits for reloaded data.
+   *
+   * @param limits This parameter stores the new limits.
+   */
+  void setLimits(Limits const &limits);
+
+  /**
+   * @brief This method replaces the current tree with a tree for the given
+   *        YAML data.
+   *
+   * Readers see the old tree until the method publishes the new one. If the
+   * data is invalid, then readers keep seeing the old tree.
+   *
+   * @param bytes This parameter stores UTF-8 encoded YAML data.
+   *
+   * @throws IllegalArgumentException If `bytes` does not store valid UTF-8
+   * @throws ParseCancellationException If `bytes` does not store valid YAML
+   *                                    data
+   */
+  void reload(string bytes);
+
+  /**
+   * @brief This method replaces the current tree.
+   *
+   * @param tree This parameter stores the new tree.
+   */
+  void publish(KeyTree tree);
+
+  /**
+   * @brief This method registers a new reader.
+   *
+   * @throws IllegalStateException If the store already has the maximum
+   *                               number of readers
+   *
+   * @return A reader that owns an unused slot of this store
+   */
+  Reader reader();
+
+  /**
+   * @brief This method deletes all retired trees no reader can still use.
+   *
+   * Reloads already delete retired trees. Call this method to release the
+   * memory of the last replaced tree without waiting for the next reload.
+   *
+   * @return The number of retired trees, which readers might still use
+   */
+  size_t reclaim();
+};
+
+#endif // YANLR_SNAPSHOT_STORE_HPP
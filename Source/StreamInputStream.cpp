@@ -0,0 +1,225 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "StreamInputStream.hpp"
+#include "UTF8InputStream.hpp"
+
+using std::to_string;
+
+using antlr4::IllegalArgumentException;
+using antlr4::IllegalStateException;
+using antlr4::UnsupportedOperationException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new stream for the given file descriptor.
+ *
+ * @param fileDescriptor This parameter specifies the (readable) file
+ *                       descriptor that the stream reads from.
+ * @param sourceName This parameter specifies the name of the input source.
+ *
+ * @throws RuntimeException If reading the input failed, or the input uses a
+ *                          compression format that this build does not
+ *                          support
+ */
+StreamInputStream::StreamInputStream(int fileDescriptor, string sourceName)
+    : source{fileDescriptor, sourceName}, name{move(sourceName)} {}
+
+/**
+ * @brief This method reads data until the buffer contains the byte at the given
+ *        index, or the input ends.
+ *
+ * @param index This parameter specifies the position of the byte that the
+ *              buffer should contain after this method returns.
+ *
+ * @throws IllegalArgumentException If the input is not valid UTF-8
+ * @throws RuntimeException If reading or decompressing the input failed
+ */
+void StreamInputStream::fill(size_t const index) {
+  while (index >= validEnd && !finished) {
+    compact();
+
+    size_t used = buffer.size();
+    buffer.resize(used + CHUNK_SIZE);
+    size_t bytes;
+    try {
+      bytes = source.read(&buffer[used], CHUNK_SIZE);
+    } catch (...) {
+      buffer.resize(used);
+      throw;
+    }
+    buffer.resize(used + bytes);
+    finished = bytes == 0;
+
+    size_t validOffset = validEnd - bufferStart;
+    size_t unchecked = buffer.size() - validOffset;
+    validEnd +=
+        UTF8InputStream::validPrefix(buffer.data() + validOffset, unchecked);
+
+    // A character might be split between two reads. We only report an error
+    // if the invalid part can not be the start of a longer character.
+    size_t rest = bufferStart + buffer.size() - validEnd;
+    if (rest > 0 && (finished || rest >= 4)) {
+      throw IllegalArgumentException("Invalid UTF-8 sequence at byte " +
+                                     to_string(validEnd));
+    }
+  }
+}
+
+/**
+ * @brief This method removes data from the buffer that neither the current
+ *        position nor any active marker requires anymore.
+ */
+void StreamInputStream::compact() {
+  size_t keep = markers > 0 ? markStart : position;
+  size_t unused = keep - bufferStart;
+
+  // We only move data if we can drop at least half of the buffer. This way
+  // the cost of moving stays linear in the size of the input.
+  if (unused == 0 || unused < buffer.size() - unused) {
+    return;
+  }
+  buffer.erase(0, unused);
+  bufferStart = keep;
+}
+
+/**
+ * @brief This method moves the stream to the next byte of the input.
+ */
+void StreamInputStream::consume() {
+  fill(position);
+  if (position >= validEnd) {
+    throw IllegalStateException("Unable to consume EOF");
+  }
+  position++;
+}
+
+/**
+ * @brief This method returns the byte at the given offset.
+ *
+ * @param offset This parameter specifies the position of the byte relative to
+ *               the current position of the stream.
+ *
+ * @return The byte at `offset` or `EOF`, if there is no such byte
+ */
+size_t StreamInputStream::LA(ssize_t offset) {
+  if (offset == 0) {
+    return 0; // The value of `LA(0)` is undefined
+  }
+  if (offset < 0) {
+    if (position < bufferStart + static_cast<size_t>(-offset)) {
+      return EOF;
+    }
+    return static_cast<unsigned char>(
+        buffer[position + offset - bufferStart]);
+  }
+
+  size_t index = position + offset - 1;
+  fill(index);
+  if (index >= validEnd) {
+    return EOF;
+  }
+  return static_cast<unsigned char>(buffer[index - bufferStart]);
+}
+
+/**
+ * @brief This method makes sure that the stream keeps all data starting at
+ *        the current position, until the marker is released.
+ *
+ * @return A marker that can be used to release the current position
+ */
+ssize_t StreamInputStream::mark() {
+  if (markers == 0) {
+    markStart = position;
+  }
+  markers++;
+  return -static_cast<ssize_t>(markers);
+}
+
+/**
+ * @brief This method releases a marker created by `mark`.
+ *
+ * @param marker This parameter specifies the marker this method releases.
+ */
+void StreamInputStream::release(ssize_t marker) {
+  if (marker != -static_cast<ssize_t>(markers)) {
+    throw IllegalStateException("Release of invalid marker");
+  }
+  markers--;
+}
+
+/**
+ * @brief This method returns the current position of the stream.
+ *
+ * @return The byte offset of the next character in the input
+ */
+size_t StreamInputStream::index() { return position; }
+
+/**
+ * @brief This method changes the current position of the stream.
+ *
+ * @param index This parameter specifies the new byte offset of the stream.
+ *              The position has to be part of the current window.
+ */
+void StreamInputStream::seek(size_t index) {
+  if (index < bufferStart) {
+    throw UnsupportedOperationException(
+        "Unable to seek to data that the stream already released");
+  }
+  fill(index);
+  position = index < validEnd ? index : validEnd;
+}
+
+/**
+ * @brief This method is not supported, since the stream does not know the size
+ *        of its input.
+ *
+ * @throws UnsupportedOperationException
+ */
+size_t StreamInputStream::size() {
+  throw UnsupportedOperationException("Unable to determine size of stream");
+}
+
+/**
+ * @brief This method returns the name of the input source.
+ *
+ * @return The name of the source this stream reads
+ */
+string StreamInputStream::getSourceName() const { return name; }
+
+/**
+ * @brief This method returns the text stored in the given interval.
+ *
+ * @param interval This parameter specifies the first and last byte of the text
+ *                 that this method returns. The interval has to be part of the
+ *                 current window.
+ *
+ * @return The UTF-8 encoded text inside `interval`
+ */
+string StreamInputStream::getText(const Interval &interval) {
+  if (interval.a < 0 || interval.b < interval.a) {
+    return "";
+  }
+  size_t start = interval.a;
+  size_t stop = interval.b;
+  if (start < bufferStart) {
+    throw UnsupportedOperationException(
+        "Unable to retrieve text that the stream already released");
+  }
+  fill(stop);
+  if (start >= validEnd) {
+    return "";
+  }
+  stop = stop < validEnd ? stop : validEnd - 1;
+  return buffer.substr(start - bufferStart, stop - start + 1);
+}
+
+/**
+ * @brief This method is not supported, since the stream does not store the
+ *        whole input.
+ *
+ * @throws UnsupportedOperationException
+ */
+string StreamInputStream::toString() const {
+  throw UnsupportedOperationException("Unable to retrieve text of stream");
+}
@@ -0,0 +1,178 @@
+#ifndef YANLR_STREAM_INPUT_STREAM_HPP
+#define YANLR_STREAM_INPUT_STREAM_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <antlr4-runtime.h>
+
+#include "Decompressor.hpp"
+
+using std::string;
+
+using antlr4::CharStream;
+using antlr4::misc::Interval;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides a character stream that reads UTF-8 encoded
+ *        bytes from a file descriptor as they arrive.
+ *
+ * If the input starts with the magic bytes of gzip or Zstandard data, then
+ * the stream decompresses it on a separate thread (see `Decompressor`).
+ *
+ * The stream only stores a window of the input. It drops data as soon as the
+ * current position moved past it and no marker (see `mark`) still requires
+ * it. Consumers that need the text of a token after the lexer moved on, have
+ * to copy the text when they create the token (e.g. via
+ * `PositionTokenFactory(true)`).
+ */
+class StreamInputStream : public CharStream {
+  /** This constant specifies the number of bytes read at once. */
+  static const size_t CHUNK_SIZE = 64 * 1024;
+
+  /** This variable stores the (decompressed) input of this stream. */
+  Decompressor source;
+
+  /** This variable stores the current window of the input. */
+  string buffer;
+
+  /** This number stores the index of the first byte stored in `buffer`. */
+  size_t bufferStart = 0;
+
+  /**
+   * This number stores the index after the last byte of `buffer` that forms
+   * a complete and valid UTF-8 character.
+   */
+  size_t validEnd = 0;
+
+  /** This number stores the index of the next character. */
+  size_t position = 0;
+
+  /** This counter stores the number of markers that are still active. */
+  size_t markers = 0;
+
+  /** This number stores the position of the first active marker. */
+  size_t markStart = 0;
+
+  /** This boolean specifies if the stream has read all of its input. */
+  bool finished = false;
+
+  /** This variable stores the name of the source this stream reads. */
+  string name;
+
+  /**
+   * @brief This method reads data until the buffer contains the byte at the
+   *        given index, or the input ends.
+   *
+   * @param index This parameter specifies the position of the byte that the
+   *              buffer should contain after this method returns.
+   *
+   * @throws IllegalArgumentException If the input is not valid UTF-8
+   * @throws RuntimeException If reading or decompressing the input failed
+   */
+  void fill(size_t const index);
+
+  /**
+   * @brief This method removes data from the buffer that neither the current
+   *        position nor any active marker requires anymore.
+   */
+  void compact();
+
+public:
+  /**
+   * @brief This constructor creates a new stream for the given file
+   *        descriptor.
+   *
+   * @param fileDescriptor This parameter specifies the (readable) file
+   *                       descriptor that the stream reads from.
+   * @param sourceName This parameter specifies the name of the input source.
+   *
+   * @throws RuntimeException If reading the input failed, or the input uses
+   *                          a compression format that this build does not
+   *                          support
+   */
+  StreamInputStream(int fileDescriptor,
+                    string sourceName = UNKNOWN_SOURCE_NAME);
+
+  /**
+   * @brief This method moves the stream to the next byte of the input.
+   */
+  void consume() override;
+
+  /**
+   * @brief This method returns the byte at the given offset.
+   *
+   * @param offset This parameter specifies the position of the byte relative
+   *               to the current position of the stream.
+   *
+   * @return The byte at `offset` or `EOF`, if there is no such byte
+   */
+  size_t LA(ssize_t offset) override;
+
+  /**
+   * @brief This method makes sure that the stream keeps all data starting
+   *        at the current position, until the marker is released.
+   *
+   * @return A marker that can be used to release the current position
+   */
+  ssize_t mark() override;
+
+  /**
+   * @brief This method releases a marker created by `mark`.
+   *
+   * @param marker This parameter specifies the marker this method releases.
+   */
+  void release(ssize_t marker) override;
+
+  /**
+   * @brief This method returns the current position of the stream.
+   *
+   * @return The byte offset of the next character in the input
+   */
+  size_t index() override;
+
+  /**
+   * @brief This method changes the current position of the stream.
+   *
+   * @param index This parameter specifies the new byte offset of the stream.
+   *              The position has to be part of the current window.
+   */
+  void seek(size_t index) override;
+
+  /**
+   * @brief This method is not supported, since the stream does not know the
+   *        size of its input.
+   *
+   * @throws UnsupportedOperationException
+   */
+  size_t size() override;
+
+  /**
+   * @brief This method returns the name of the input source.
+   *
+   * @return The name of the source this stream reads
+   */
+  string getSourceName() const override;
+
+  /**
+   * @brief This method returns the text stored in the given interval.
+   *
+   * @param interval This parameter specifies the first and last byte of the
+   *                 text that this method returns. The interval has to be
+   *                 part of the current window.
+   *
+   * @return The UTF-8 encoded text inside `interval`
+   */
+  string getText(const Interval &interval) override;
+
+  /**
+   * @brief This method is not supported, since the stream does not store the
+   *        whole input.
+   *
+   * @throws UnsupportedOperationException
+   */
+  string toString() const override;
+};
+
+#endif // YANLR_STREAM_INPUT_STREAM_HPP
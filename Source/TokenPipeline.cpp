@@ -0,0 +1,183 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "TokenPipeline.hpp"
+
+using std::current_exception;
+using std::memory_order_acquire;
+using std::memory_order_relaxed;
+using std::memory_order_release;
+using std::rethrow_exception;
+
+using antlr4::IllegalStateException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This destructor stops the producer thread.
+ */
+TokenPipeline::~TokenPipeline() { stop(); }
+
+/**
+ * @brief This method starts retrieving tokens from the given source.
+ *
+ * @param tokenSource This parameter specifies the token source, which the
+ *                    pipeline runs on a separate thread. The pipeline accesses
+ *                    the source only from this thread, until `stop` returns.
+ */
+void TokenPipeline::start(TokenSource *tokenSource) {
+  stop();
+  source = tokenSource;
+  head.store(0, memory_order_relaxed);
+  tail.store(0, memory_order_relaxed);
+  finished.store(false, memory_order_relaxed);
+  cancelled.store(false, memory_order_relaxed);
+  error = nullptr;
+  ended = false;
+  line = 1;
+  column = 0;
+  // Starting the thread synchronizes with the producer, so the relaxed stores
+  // above are visible to it
+  producer = thread{&TokenPipeline::produce, this};
+}
+
+/**
+ * @brief This method stops the producer thread and removes all tokens the
+ *        consumer did not take out of the pipeline.
+ */
+void TokenPipeline::stop() {
+  if (!producer.joinable()) {
+    return;
+  }
+  cancelled.store(true, memory_order_relaxed);
+  producer.join();
+
+  for (size_t index = head.load(memory_order_relaxed),
+              end = tail.load(memory_order_relaxed);
+       index != end; index++) {
+    delete slots[index & (CAPACITY - 1)];
+  }
+  head.store(tail.load(memory_order_relaxed), memory_order_relaxed);
+}
+
+/**
+ * @brief This method retrieves tokens from `source` and publishes them, until
+ *        it read `EOF`, `source` failed or the pipeline was stopped.
+ */
+void TokenPipeline::produce() {
+  size_t end = tail.load(memory_order_relaxed);
+  size_t published = end;
+  // We only read the position of the consumer, if the ring seems to be full
+  size_t start = head.load(memory_order_acquire);
+
+  try {
+    while (!cancelled.load(memory_order_relaxed)) {
+      while (end - start == CAPACITY) {
+        // Publish the last (partial) batch, so the consumer can make room
+        tail.store(end, memory_order_release);
+        published = end;
+        if (cancelled.load(memory_order_relaxed)) {
+          break;
+        }
+        std::this_thread::yield();
+        start = head.load(memory_order_acquire);
+      }
+      if (end - start == CAPACITY) {
+        break;
+      }
+
+      unique_ptr<Token> token = source->nextToken();
+      bool const last = token->getType() == Token::EOF;
+      slots[end & (CAPACITY - 1)] = token.release();
+      end++;
+
+      if (last || end - published >= BATCH) {
+        tail.store(end, memory_order_release);
+        published = end;
+      }
+      if (last) {
+        break;
+      }
+    }
+  } catch (...) {
+    error = current_exception();
+  }
+  tail.store(end, memory_order_release);
+  finished.store(true, memory_order_release);
+}
+
+/**
+ * @brief This method returns the next token produced by the wrapped source.
+ *
+ * @throws The exception thrown by the wrapped source, after the consumer took
+ *         all tokens produced before the error
+ *
+ * @return A token of the token stream produced by the wrapped source
+ */
+unique_ptr<Token> TokenPipeline::nextToken() {
+  if (ended) {
+    // Token streams should not ask for more tokens after `EOF`, but if they
+    // do we repeat it
+    return unique_ptr<Token>{
+        getTokenFactory()->create(Token::EOF, "<EOF>").release()};
+  }
+
+  size_t const index = head.load(memory_order_relaxed);
+  while (tail.load(memory_order_acquire) == index) {
+    if (finished.load(memory_order_acquire) &&
+        tail.load(memory_order_acquire) == index) {
+      if (error) {
+        rethrow_exception(error);
+      }
+      throw IllegalStateException("Token pipeline stopped before EOF");
+    }
+    std::this_thread::yield();
+  }
+
+  unique_ptr<Token> token{slots[index & (CAPACITY - 1)]};
+  head.store(index + 1, memory_order_release);
+
+  ended = token->getType() == Token::EOF;
+  line = token->getLine();
+  column = token->getCharPositionInLine();
+  return token;
+}
+
+/**
+ * @brief This method retrieves the line of the last returned token.
+ *
+ * @return The line number of the last token returned by `nextToken`
+ */
+size_t TokenPipeline::getLine() const { return line; }
+
+/**
+ * @brief This method returns the column of the last returned token.
+ *
+ * @return The position inside its line of the last token returned by
+ *         `nextToken`
+ */
+size_t TokenPipeline::getCharPositionInLine() { return column; }
+
+/**
+ * @brief This method returns the input of the wrapped source.
+ *
+ * @return The character stream the wrapped source is scanning
+ */
+CharStream *TokenPipeline::getInputStream() {
+  return source->getInputStream();
+}
+
+/**
+ * @brief This method retrieves the name of the input of the wrapped source.
+ *
+ * @return The name of the current input source
+ */
+std::string TokenPipeline::getSourceName() { return source->getSourceName(); }
+
+/**
+ * @brief Retrieve the token factory of the wrapped source.
+ *
+ * @return The factory the wrapped source uses to create tokens
+ */
+Ref<TokenFactory<CommonToken>> TokenPipeline::getTokenFactory() {
+  return source->getTokenFactory();
+}
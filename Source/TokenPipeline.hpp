@@ -0,0 +1,156 @@
+#ifndef YANLR_TOKEN_PIPELINE_HPP
+#define YANLR_TOKEN_PIPELINE_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <thread>
+
+#include <antlr4-runtime.h>
+
+using std::atomic;
+using std::exception_ptr;
+using std::thread;
+using std::unique_ptr;
+
+using antlr4::CharStream;
+using antlr4::CommonToken;
+using antlr4::Token;
+using antlr4::TokenFactory;
+using antlr4::TokenSource;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This token source runs another token source on a separate thread.
+ *
+ * The producer thread retrieves tokens from the wrapped source and publishes
+ * them in batches into a lock-free single-producer/single-consumer ring. The
+ * consuming thread (usually the grammar parser) takes tokens out of the ring,
+ * so lexing and parsing overlap.
+ *
+ * The wrapped source must create tokens that do not depend on its state
+ * afterwards. For the YAML lexer this means a token factory that stores the
+ * line and column of each token right away (like `CommonTokenFactory`).
+ */
+class TokenPipeline : public TokenSource {
+  /** This number specifies the number of slots in the ring (a power of 2). */
+  static size_t const CAPACITY = 4096;
+
+  /** This number specifies how many tokens the producer publishes at once. */
+  static size_t const BATCH = 64;
+
+  /** This variable stores the token source of the producer thread. */
+  TokenSource *source = nullptr;
+
+  /** This ring stores the tokens produced, but not yet consumed. */
+  unique_ptr<Token *[]> slots{new Token *[CAPACITY]};
+
+  /** This counter stores the number of tokens taken out of the ring. */
+  atomic<size_t> head{0};
+
+  /** This counter stores the number of tokens published into the ring. */
+  atomic<size_t> tail{0};
+
+  /** This boolean specifies if the producer thread stopped. */
+  atomic<bool> finished{true};
+
+  /** This boolean tells the producer thread to stop early. */
+  atomic<bool> cancelled{false};
+
+  /**
+   * This variable stores the exception thrown by `source`. The producer
+   * writes it before it sets `finished`.
+   */
+  exception_ptr error;
+
+  /** This thread retrieves tokens from `source`. */
+  thread producer;
+
+  /** This boolean specifies if the consumer already received `EOF`. */
+  bool ended = false;
+
+  /** This number stores the line of the last consumed token. */
+  size_t line = 1;
+
+  /** This number stores the column of the last consumed token. */
+  size_t column = 0;
+
+  /**
+   * @brief This method retrieves tokens from `source` and publishes them,
+   *        until it read `EOF`, `source` failed or the pipeline was stopped.
+   */
+  void produce();
+
+public:
+  /**
+   * @brief This destructor stops the producer thread.
+   */
+  ~TokenPipeline();
+
+  /**
+   * @brief This method starts retrieving tokens from the given source.
+   *
+   * @param tokenSource This parameter specifies the token source, which the
+   *                    pipeline runs on a separate thread. The pipeline
+   *                    accesses the source only from this thread, until
+   *                    `stop` returns.
+   */
+  void start(TokenSource *tokenSource);
+
+  /**
+   * @brief This method stops the producer thread and removes all tokens
+   *        the consumer did not take out of the pipeline.
+   */
+  void stop();
+
+  /**
+   * @brief This method returns the next token produced by the wrapped source.
+   *
+   * @throws The exception thrown by the wrapped source, after the consumer
+   *         took all tokens produced before the error
+   *
+   * @return A token of the token stream produced by the wrapped source
+   */
+  unique_ptr<Token> nextToken() override;
+
+  /**
+   * @brief This method retrieves the line of the last returned token.
+   *
+   * @return The line number of the last token returned by `nextToken`
+   */
+  size_t getLine() const override;
+
+  /**
+   * @brief This method returns the column of the last returned token.
+   *
+   * @return The position inside its line of the last token returned by
+   *         `nextToken`
+   */
+  size_t getCharPositionInLine() override;
+
+  /**
+   * @brief This method returns the input of the wrapped source.
+   *
+   * @return The character stream the wrapped source is scanning
+   */
+  CharStream *getInputStream() override;
+
+  /**
+   * @brief This method retrieves the name of the input of the wrapped source.
+   *
+   * @return The name of the current input source
+   */
+  std::string getSourceName() override;
+
+  /**
+   * @brief Retrieve the token factory of the wrapped source.
+   *
+   * @return The factory the wrapped source uses to create tokens
+   */
+  Ref<TokenFactory<CommonToken>> getTokenFactory() override;
+};
+
+#endif // YANLR_TOKEN_PIPELINE_HPP
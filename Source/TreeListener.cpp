@@ -0,0 +1,260 @@
+// -- Imports ------------------------------------------------------------------
+
+#include "Conversion.hpp"
+#include "TreeListener.hpp"
+
+using std::to_string;
+
+using antlr4::ParseCancellationException;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new empty tree using the given parent key.
+ *
+ * @param parent This parameter specifies the name of the parent of all keys
+ *               stored in the object.
+ */
+TreeListener::TreeListener(string parent) : tree{move(parent)} {
+  parents.push(KeyTree::ROOT);
+}
+
+/**
+ * @brief This method removes all nodes from the tree and sets a new parent
+ *        key.
+ *
+ * @param parent This parameter specifies the name of the parent of all keys
+ *               stored in the object.
+ */
+void TreeListener::reset(string parent) {
+  tree = KeyTree{move(parent)};
+  parents = stack<KeyTree::Node>{};
+  indices = stack<uintmax_t>{};
+  mappings = stack<unordered_map<string, Token *>>{};
+  anchors.clear();
+  aliasNodes = 0;
+  nodesSinceCheck = 0;
+  parents.push(KeyTree::ROOT);
+}
+
+/**
+ * @brief This function returns the data read by the parser.
+ *
+ * @return The tree representing the data from the textual input, with the
+ *         children of each node ordered by base name
+ */
+KeyTree TreeListener::keyTree() {
+  tree.sortChildren();
+  return tree;
+}
+
+/**
+ * @brief This method specifies the resource limits for a single document.
+ *
+ * The listener applies the key limits to the number of nodes in the tree.
+ *
+ * @param documentLimits This parameter stores the new limits.
+ */
+void TreeListener::setLimits(Limits const &documentLimits) {
+  limits = documentLimits;
+}
+
+/**
+ * @brief This method adds a level to the current key name and checks the
+ *        limits.
+ *
+ * @param token This parameter stores the token that starts the new level.
+ * @param node This parameter specifies the node of the new level.
+ *
+ * @throws ParseCancellationException If the tree exceeds the depth or key
+ *                                    limit or the deadline passed
+ */
+void TreeListener::pushNode(Token *token, KeyTree::Node const node) {
+  // The stack also contains the root node, which does not count as level
+  if (parents.size() > limits.depth) {
+    throw ParseCancellationException(
+        ErrorListener::position(token) +
+        " Nesting depth exceeds the limit of " + to_string(limits.depth));
+  }
+  // The tree also contains the root node
+  if (tree.size() - 1 > limits.keys) {
+    throw ParseCancellationException(ErrorListener::position(token) +
+                                     " Number of keys exceeds the limit of " +
+                                     to_string(limits.keys));
+  }
+  if (++nodesSinceCheck >= 256) {
+    nodesSinceCheck = 0;
+    if (std::chrono::steady_clock::now() > limits.deadline) {
+      throw ParseCancellationException("Converting the parse tree to keys "
+                                       "exceeded the deadline");
+    }
+  }
+  parents.push(node);
+}
+
+/**
+ * @brief This function will be called after the parser enters a child node.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::enterChild(ChildContext *context) {
+  if (!context->ALIAS()) {
+    return;
+  }
+
+  antlr4::Token *alias = context->ALIAS()->getSymbol();
+  string const name = alias->getText().substr(1);
+  string const position = ErrorListener::position(alias) + " ";
+  auto anchor = anchors.find(name);
+  if (anchor == anchors.end()) {
+    throw ParseCancellationException(position + "Unknown alias “" + name +
+                                     "”");
+  }
+
+  // A merge key (`<<`) copies the nodes to its parent, keeping existing keys
+  KeyTree::Node target = parents.top();
+  bool const merge = mergeKey;
+  if (merge) {
+    parents.pop();
+    KeyTree::Node const mergeNode = target;
+    target = parents.top();
+    parents.push(mergeNode);
+  }
+  aliasNodes +=
+      tree.copy(anchor->second, target, merge, limits.aliasKeys - aliasNodes);
+  if (aliasNodes > limits.aliasKeys) {
+    throw ParseCancellationException(
+        position + "Expanding alias “" + name + "” exceeds the limit of " +
+        to_string(limits.aliasKeys) + " nodes created by aliases");
+  }
+}
+
+/**
+ * @brief This function will be called after the parser exits a child node.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::exitChild(ChildContext *context) {
+  if (context->ANCHOR()) {
+    anchors[context->ANCHOR()->getText().substr(1)] = parents.top();
+  }
+}
+
+/**
+ * @brief This function will be called after the parser exits a value.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::exitValue(ValueContext *context) {
+  tree.setValue(parents.top(), scalarToText(context->getText()));
+}
+
+/**
+ * @brief This function will be called after the parser enters a mapping.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::enterMap(MapContext *context __attribute__((unused))) {
+  mappings.push(unordered_map<string, Token *>{});
+}
+
+/**
+ * @brief This function will be called after the parser exits a mapping.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::exitMap(MapContext *context __attribute__((unused))) {
+  mappings.pop();
+}
+
+/**
+ * @brief This function will be called after the parser enters a key-value pair.
+ *
+ * @param context The context specifies data matched by the rule.
+ *
+ * @throws ParseCancellationException If the mapping already contains the key
+ *                                    of the pair
+ */
+void TreeListener::enterPair(PairContext *context) {
+  string const name = scalarToText(context->key()->getText());
+  auto inserted = mappings.top().insert({name, context->key()->getStart()});
+  if (!inserted.second) {
+    throw ParseCancellationException(
+        ErrorListener::position(context->key()->getStart()) +
+        " Duplicate key “" + name + "” (first occurrence at " +
+        ErrorListener::position(inserted.first->second) + ")");
+  }
+
+  KeyTree::Node child = tree.child(parents.top(), name);
+  pushNode(context->key()->getStart(), child);
+  // Quoted scalars such as `'<<'` are ordinary keys
+  mergeKey = name == "<<" && context->key()->scalar()->PLAIN_SCALAR();
+  if (!context->child()) {
+    // The parser does not visit `exitValue` for a key with an empty value
+    tree.setKey(child);
+  }
+}
+
+/**
+ * @brief This function will be called after the parser exits a key-value pair.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::exitPair(PairContext *context __attribute__((unused))) {
+  parents.pop();
+  mergeKey = false;
+}
+
+/**
+ * @brief This function will be called after the parser enters a sequence.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::enterSequence(SequenceContext *context
+                                 __attribute__((unused))) {
+  indices.push(0);
+  tree.setArray(parents.top());
+}
+
+/**
+ * @brief This function will be called after the parser exits a sequence.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::exitSequence(SequenceContext *context
+                                __attribute__((unused))) {
+  tree.setKey(parents.top());
+  indices.pop();
+}
+
+/**
+ * @brief This function will be called after the parser recognizes an element
+ *        of a sequence.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::enterElement(ElementContext *context) {
+  mergeKey = false;
+  KeyTree::Node element =
+      tree.child(parents.top(), indexToArrayBaseName(indices.top()));
+
+  uintmax_t index = indices.top();
+  indices.pop();
+  if (index < UINTMAX_MAX) {
+    index++;
+  }
+  indices.push(index);
+
+  pushNode(context->ELEMENT()->getSymbol(), element);
+}
+
+/**
+ * @brief This function will be called after the parser read an element of a
+ *        sequence.
+ *
+ * @param context The context specifies data matched by the rule.
+ */
+void TreeListener::exitElement(ElementContext *context
+                               __attribute__((unused))) {
+  parents.pop();
+}
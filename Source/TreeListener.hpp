@@ -0,0 +1,205 @@
+#ifndef YANLR_TREE_LISTENER_HPP
+#define YANLR_TREE_LISTENER_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <stack>
+#include <unordered_map>
+
+#include "YAMLBaseListener.h"
+
+#include "ErrorListener.hpp"
+#include "KeyTree.hpp"
+#include "Limits.hpp"
+
+using std::stack;
+using std::unordered_map;
+
+using antlr::YAMLBaseListener;
+using ChildContext = antlr::YAML::ChildContext;
+using MapContext = antlr::YAML::MapContext;
+using ValueContext = antlr::YAML::ValueContext;
+using PairContext = antlr::YAML::PairContext;
+using SequenceContext = antlr::YAML::SequenceContext;
+using ElementContext = antlr::YAML::ElementContext;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class creates a key tree by listening to matches of grammar
+ *        rules specified via YAML.g4.
+ *
+ * The listener stores the same data as `KeyListener`, but it does not create
+ * a key (and therefore a copy of the full key name) for every node.
+ */
+class TreeListener : public YAMLBaseListener {
+  /** This variable stores a tree representing the textual input. */
+  KeyTree tree;
+
+  /** This stack stores a node for each level of the current key name. */
+  stack<KeyTree::Node> parents;
+
+  /**
+   * This stack stores indices for the next array elements.
+   */
+  stack<uintmax_t> indices;
+
+  /**
+   * This stack stores the keys of each mapping we are currently inside. Each
+   * key (base name) points to the token of its first occurrence.
+   */
+  stack<unordered_map<string, Token *>> mappings;
+
+  /**
+   * This boolean specifies if the current key is a merge key (a plain `<<`
+   * scalar).
+   */
+  bool mergeKey = false;
+
+  /** This map stores the anchored nodes of the input by anchor name. */
+  unordered_map<string, KeyTree::Node> anchors;
+
+  /** This number stores the number of nodes created by aliases. */
+  size_t aliasNodes = 0;
+
+  /** This variable stores the resource limits for a single document. */
+  Limits limits;
+
+  /** This number counts the nodes added since the last deadline check. */
+  size_t nodesSinceCheck = 0;
+
+  /**
+   * @brief This method adds a level to the current key name and checks the
+   *        limits.
+   *
+   * @param token This parameter stores the token that starts the new level.
+   * @param node This parameter specifies the node of the new level.
+   *
+   * @throws ParseCancellationException If the tree exceeds the depth or key
+   *                                    limit or the deadline passed
+   */
+  void pushNode(Token *token, KeyTree::Node const node);
+
+public:
+  /**
+   * @brief This constructor creates a new empty tree using the given parent
+   *        key.
+   *
+   * @param parent This parameter specifies the name of the parent of all keys
+   *               stored in the object.
+   */
+  TreeListener(string parent);
+
+  /**
+   * @brief This method removes all nodes from the tree and sets a new parent
+   *        key.
+   *
+   * @param parent This parameter specifies the name of the parent of all keys
+   *               stored in the object.
+   */
+  void reset(string parent);
+
+  /**
+   * @brief This function returns the data read by the parser.
+   *
+   * @return The tree representing the data from the textual input, with the
+   *         children of each node ordered by base name
+   */
+  KeyTree keyTree();
+
+  /**
+   * @brief This method specifies the resource limits for a single document.
+   *
+   * The listener applies the key limits to the number of nodes in the tree.
+   *
+   * @param documentLimits This parameter stores the new limits.
+   */
+  void setLimits(Limits const &documentLimits);
+
+  /**
+   * @brief This function will be called after the parser enters a child
+   *        node.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterChild(ChildContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a child node.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitChild(ChildContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a value.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitValue(ValueContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a mapping.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void enterMap(MapContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a mapping.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  void exitMap(MapContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a key-value
+   *        pair.
+   *
+   * @param context The context specifies data matched by the rule.
+   *
+   * @throws ParseCancellationException If the mapping already contains the
+   *                                    key of the pair
+   */
+  virtual void enterPair(PairContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a key-value
+   *        pair.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  virtual void exitPair(PairContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser enters a sequence.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  virtual void enterSequence(SequenceContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser exits a sequence.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  virtual void exitSequence(SequenceContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser recognizes an element
+   *        of a sequence.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  virtual void enterElement(ElementContext *context) override;
+
+  /**
+   * @brief This function will be called after the parser read an element of a
+   *        sequence.
+   *
+   * @param context The context specifies data matched by the rule.
+   */
+  virtual void exitElement(ElementContext *context) override;
+};
+
+#endif // YANLR_TREE_LISTENER_HPP
@@ -0,0 +1,241 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cstring>
+
+#include "UTF8InputStream.hpp"
+
+using std::to_string;
+
+using antlr4::IllegalArgumentException;
+using antlr4::IllegalStateException;
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * @brief This function checks if the given byte is a UTF-8 continuation byte.
+ *
+ * @param byte This parameter stores the byte this function checks.
+ *
+ * @retval true If `byte` has the form `10xxxxxx`
+ *         false Otherwise
+ */
+inline bool isContinuation(unsigned char const byte) {
+  return (byte & 0xC0) == 0x80;
+}
+
+/**
+ * @brief This function returns the length of the UTF-8 character at the given
+ *        position.
+ *
+ * @param text This parameter points to the first byte of the character.
+ * @param length This parameter specifies the number of bytes available at
+ *               `text`.
+ *
+ * @return The length of the character in bytes or `0`, if the bytes at `text`
+ *         do not store a complete and valid UTF-8 character
+ */
+size_t characterLength(unsigned char const *text, size_t const length) {
+  unsigned char const first = text[0];
+  if (first < 0x80) {
+    return 1;
+  }
+  if (first >= 0xC2 && first <= 0xDF) {
+    return length >= 2 && isContinuation(text[1]) ? 2 : 0;
+  }
+  if (first >= 0xE0 && first <= 0xEF) {
+    if (length < 3 || !isContinuation(text[1]) || !isContinuation(text[2])) {
+      return 0;
+    }
+    // Reject overlong encodings and UTF-16 surrogates
+    if ((first == 0xE0 && text[1] < 0xA0) ||
+        (first == 0xED && text[1] > 0x9F)) {
+      return 0;
+    }
+    return 3;
+  }
+  if (first >= 0xF0 && first <= 0xF4) {
+    if (length < 4 || !isContinuation(text[1]) || !isContinuation(text[2]) ||
+        !isContinuation(text[3])) {
+      return 0;
+    }
+    // Reject overlong encodings and code points above `U+10FFFF`
+    if ((first == 0xF0 && text[1] < 0x90) ||
+        (first == 0xF4 && text[1] > 0x8F)) {
+      return 0;
+    }
+    return 4;
+  }
+  return 0;
+}
+
+} // namespace
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This constructor creates a new stream for the given text.
+ *
+ * @param text This parameter stores the UTF-8 encoded input of the stream.
+ * @param sourceName This parameter specifies the name of the input source.
+ *
+ * @throws IllegalArgumentException If `text` is not valid UTF-8
+ */
+UTF8InputStream::UTF8InputStream(string text, string sourceName)
+    : data{move(text)}, name{move(sourceName)} {
+  size_t valid = validPrefix(data.data(), data.size());
+  if (valid < data.size()) {
+    throw IllegalArgumentException("Invalid UTF-8 sequence at byte " +
+                                   to_string(valid));
+  }
+}
+
+/**
+ * @brief This function returns the length of the longest valid UTF-8 prefix
+ *        of the given bytes.
+ *
+ * The function checks eight bytes at once as long as the input only contains
+ * ASCII characters.
+ *
+ * @param text This parameter points to the start of the checked bytes.
+ * @param length This parameter specifies the number of bytes to check.
+ *
+ * @return The number of bytes (starting at `text`), that form a sequence of
+ *         complete and valid UTF-8 characters
+ */
+size_t UTF8InputStream::validPrefix(char const *text, size_t const length) {
+  unsigned char const *bytes = reinterpret_cast<unsigned char const *>(text);
+  uint64_t const highBits = 0x8080808080808080;
+
+  size_t offset = 0;
+  while (offset < length) {
+    // Skip blocks of ASCII characters
+    while (offset + sizeof(uint64_t) <= length) {
+      uint64_t block;
+      memcpy(&block, bytes + offset, sizeof(uint64_t));
+      if (block & highBits) {
+        break;
+      }
+      offset += sizeof(uint64_t);
+    }
+    if (offset >= length) {
+      break;
+    }
+
+    size_t characterSize = characterLength(bytes + offset, length - offset);
+    if (characterSize == 0) {
+      return offset;
+    }
+    offset += characterSize;
+  }
+  return length;
+}
+
+/**
+ * @brief This method moves the stream to the next byte of the input.
+ */
+void UTF8InputStream::consume() {
+  if (position >= data.size()) {
+    throw IllegalStateException("Unable to consume EOF");
+  }
+  position++;
+}
+
+/**
+ * @brief This method returns the byte at the given offset.
+ *
+ * @param offset This parameter specifies the position of the byte relative to
+ *               the current position of the stream.
+ *
+ * @return The byte at `offset` or `EOF`, if there is no such byte
+ */
+size_t UTF8InputStream::LA(ssize_t offset) {
+  if (offset == 0) {
+    return 0; // The value of `LA(0)` is undefined
+  }
+  ssize_t index =
+      static_cast<ssize_t>(position) + (offset < 0 ? offset : offset - 1);
+  if (index < 0 || static_cast<size_t>(index) >= data.size()) {
+    return EOF;
+  }
+  return static_cast<unsigned char>(data[index]);
+}
+
+/**
+ * @brief This method marks the current position of the stream.
+ *
+ * @return A marker that can be used to release the current position
+ */
+ssize_t UTF8InputStream::mark() { return -1; }
+
+/**
+ * @brief This method releases a marker created by `mark`.
+ *
+ * @param marker This parameter specifies the marker this method releases.
+ */
+void UTF8InputStream::release(ssize_t marker __attribute__((unused))) {}
+
+/**
+ * @brief This method returns the current position of the stream.
+ *
+ * @return The byte offset of the next character in the input
+ */
+size_t UTF8InputStream::index() { return position; }
+
+/**
+ * @brief This method changes the current position of the stream.
+ *
+ * @param index This parameter specifies the new byte offset of the stream.
+ */
+void UTF8InputStream::seek(size_t index) {
+  position = index < data.size() ? index : data.size();
+}
+
+/**
+ * @brief This method returns the bytes stored in the stream.
+ *
+ * @return A pointer to the first of `size()` contiguous bytes, which stays
+ *         valid until the stream changes
+ */
+char const *UTF8InputStream::bytes() const { return data.data(); }
+
+/**
+ * @brief This method returns the size of the stream.
+ *
+ * @return The number of bytes stored in the stream
+ */
+size_t UTF8InputStream::size() { return data.size(); }
+
+/**
+ * @brief This method returns the name of the input source.
+ *
+ * @return The name of the source this stream reads
+ */
+string UTF8InputStream::getSourceName() const { return name; }
+
+/**
+ * @brief This method returns the text stored in the given interval.
+ *
+ * @param interval This parameter specifies the first and last byte of the text
+ *                 that this method returns.
+ *
+ * @return The UTF-8 encoded text inside `interval`
+ */
+string UTF8InputStream::getText(const Interval &interval) {
+  if (interval.a < 0 || interval.b < interval.a ||
+      static_cast<size_t>(interval.a) >= data.size()) {
+    return "";
+  }
+  size_t start = interval.a;
+  size_t stop = static_cast<size_t>(interval.b) < data.size() ? interval.b
+                                                              : data.size() - 1;
+  return data.substr(start, stop - start + 1);
+}
+
+/**
+ * @brief This method returns the text of the whole input.
+ *
+ * @return The text stored in the stream
+ */
+string UTF8InputStream::toString() const { return data; }
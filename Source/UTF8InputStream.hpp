@@ -0,0 +1,142 @@
+#ifndef YANLR_UTF8_INPUT_STREAM_HPP
+#define YANLR_UTF8_INPUT_STREAM_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <antlr4-runtime.h>
+
+using std::string;
+
+using antlr4::CharStream;
+using antlr4::misc::Interval;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This class provides a character stream over UTF-8 encoded bytes.
+ *
+ * Unlike `ANTLRInputStream`, this stream does not decode its input to UTF-32.
+ * The lookahead functions return single bytes and indices are byte offsets.
+ * Since all structural characters of YAML are part of ASCII, the lexer does
+ * not need to know about multi-byte characters.
+ */
+class UTF8InputStream : public CharStream {
+  /** This variable stores the (validated) input of the stream. */
+  string data;
+
+  /** This number stores the byte offset of the next character. */
+  size_t position = 0;
+
+  /** This variable stores the name of the source this stream reads. */
+  string name;
+
+public:
+  /**
+   * @brief This constructor creates a new stream for the given text.
+   *
+   * @param text This parameter stores the UTF-8 encoded input of the stream.
+   * @param sourceName This parameter specifies the name of the input source.
+   *
+   * @throws IllegalArgumentException If `text` is not valid UTF-8
+   */
+  UTF8InputStream(string text, string sourceName = UNKNOWN_SOURCE_NAME);
+
+  /**
+   * @brief This function returns the length of the longest valid UTF-8 prefix
+   *        of the given bytes.
+   *
+   * The function checks eight bytes at once as long as the input only contains
+   * ASCII characters.
+   *
+   * @param text This parameter points to the start of the checked bytes.
+   * @param length This parameter specifies the number of bytes to check.
+   *
+   * @return The number of bytes (starting at `text`), that form a sequence of
+   *         complete and valid UTF-8 characters
+   */
+  static size_t validPrefix(char const *text, size_t const length);
+
+  /**
+   * @brief This method moves the stream to the next byte of the input.
+   */
+  void consume() override;
+
+  /**
+   * @brief This method returns the byte at the given offset.
+   *
+   * @param offset This parameter specifies the position of the byte relative
+   *               to the current position of the stream.
+   *
+   * @return The byte at `offset` or `EOF`, if there is no such byte
+   */
+  size_t LA(ssize_t offset) override;
+
+  /**
+   * @brief This method marks the current position of the stream.
+   *
+   * @return A marker that can be used to release the current position
+   */
+  ssize_t mark() override;
+
+  /**
+   * @brief This method releases a marker created by `mark`.
+   *
+   * @param marker This parameter specifies the marker this method releases.
+   */
+  void release(ssize_t marker) override;
+
+  /**
+   * @brief This method returns the current position of the stream.
+   *
+   * @return The byte offset of the next character in the input
+   */
+  size_t index() override;
+
+  /**
+   * @brief This method changes the current position of the stream.
+   *
+   * @param index This parameter specifies the new byte offset of the stream.
+   */
+  void seek(size_t index) override;
+
+  /**
+   * @brief This method returns the bytes stored in the stream.
+   *
+   * @return A pointer to the first of `size()` contiguous bytes, which stays
+   *         valid until the stream changes
+   */
+  char const *bytes() const;
+
+  /**
+   * @brief This method returns the size of the stream.
+   *
+   * @return The number of bytes stored in the stream
+   */
+  size_t size() override;
+
+  /**
+   * @brief This method returns the name of the input source.
+   *
+   * @return The name of the source this stream reads
+   */
+  string getSourceName() const override;
+
+  /**
+   * @brief This method returns the text stored in the given interval.
+   *
+   * @param interval This parameter specifies the first and last byte of the
+   *                 text that this method returns.
+   *
+   * @return The UTF-8 encoded text inside `interval`
+   */
+  string getText(const Interval &interval) override;
+
+  /**
+   * @brief This method returns the text of the whole input.
+   *
+   * @return The text stored in the stream
+   */
+  string toString() const override;
+};
+
+#endif // YANLR_UTF8_INPUT_STREAM_HPP
@@ -13,277 +13,47 @@
  * .
  */
 
-// -- Macros -------------------------------------------------------------------
-
-#define SPDLOG_TRACE_ON
-#define LOGF(fmt, ...)                                                         \
-  console->trace("{}:{}: " fmt, __FUNCTION__, __LINE__, __VA_ARGS__);
-#define LOG(text) console->trace("{}:{}: {}", __FUNCTION__, __LINE__, text);
+#ifndef YANLR_YAML_LEXER_HPP
+#define YANLR_YAML_LEXER_HPP
 
 // -- Imports ------------------------------------------------------------------
 
 #include <antlr4-runtime.h>
-#include <spdlog/sinks/stdout_color_sinks.h>
-#include <spdlog/spdlog.h>
 
-using std::deque;
-using std::pair;
-using std::shared_ptr;
-using std::stack;
-using std::string;
-using std::unique_ptr;
+#include "LexerCore.hpp"
 
 using antlr4::CharStream;
 using antlr4::CommonToken;
-using antlr4::CommonTokenFactory;
 using antlr4::Token;
 using antlr4::TokenFactory;
 using antlr4::TokenSource;
 
-using spdlog::logger;
-
 // -- Class --------------------------------------------------------------------
 
+/**
+ * @brief This class provides the YAML lexer as ANTLR token source.
+ *
+ * The lexer forwards all work to a `LexerCore`. If the input is a
+ * `UTF8InputStream`, then the lexer uses the core that reads the buffer of the
+ * stream directly. Other streams go through the `CharStream` interface. The
+ * buffer core moves the `UTF8InputStream` to the end of the input after it
+ * emitted the last token, and leaves the stream untouched before.
+ */
 class YAMLLexer : public TokenSource {
   /** This variable stores the input that this lexer scans. */
   CharStream *input;
 
-  /** This queue stores the list of tokens produced by the lexer. */
-  deque<unique_ptr<CommonToken>> tokens;
-
-  /** The lexer uses this factory to produce tokens. */
-  Ref<TokenFactory<CommonToken>> factory = CommonTokenFactory::DEFAULT;
-
-  /** This pair stores the token source (this lexer) and the current `input`. */
-  pair<TokenSource *, CharStream *> source;
-
-  /**
-   * This variable saves the current line position of the lexer inside
-   * `input`.
-   */
-  size_t line = 1;
-
-  /**
-   * This number stores the current character position of the lexer inside of
-   * `line`.
-   */
-  size_t column = 1;
-
-  /**
-   * This counter stores the number of tokens already emitted by the lexer.
-   * The lexer needs this variable, to keep track of the insertion point of
-   * `KEY` tokens in the token queue.
-   */
-  size_t tokensEmitted = 0;
-
-  /**
-   * This stack stores the indentation (in number of characters) for each
-   * block collection.
-   */
-  stack<size_t> indents{deque<size_t>{0}};
-
-  /**
-   * This boolean specifies if the lexer has already scanned the whole input or
-   * not.
-   */
-  bool done = false;
-
-  /**
-   * This pair stores a simple key candidate token (first part) and its
-   * position in the token queue (second part).
-   *
-   * Since the lexer only supports block syntax for mappings and sequences we
-   * use a single token here. If we need support for flow collections we have
-   * to store a candidate for each flow level (block context = flow level 0).
-   */
-  pair<unique_ptr<CommonToken>, size_t> simpleKey;
-
-  /**
-   * This variable stores the logger used by the lexer to print debug messages.
-   */
-  shared_ptr<logger> console;
-
-  /**
-   * @brief This function creates a new token with the specified parameters.
-   *
-   * @param type This parameter specifies the type of the token this function
-   *             should create.
-   * @param start This number specifies the start index of the returned token
-   *              inside the character stream `input`.
-   * @param stop This number specifies the stop index of the returned token
-   *             inside the character stream `input`.
-   * @param text This string specifies the text of the returned token.
-   *
-   * @return A token with the specified parameters
-   */
-  unique_ptr<CommonToken> commonToken(size_t type, size_t start, size_t stop,
-                                      string text);
-
-  /**
-   * @brief This function creates a new token with the specified parameters.
-   *
-   * @param type This parameter specifies the type of the token this function
-   *             should create.
-   * @param start This number specifies the start index of the returned token
-   *              inside the character stream `input`.
-   * @param stop This number specifies the stop index of the returned token
-   *             inside the character stream `input`.
-   *
-   * @return A token with the specified parameters
-   */
-  unique_ptr<CommonToken> commonToken(size_t type, size_t start, size_t stop);
-
-  /**
-   * @brief This function adds an indentation value if the given value is
-   *        smaller than the current indentation.
-   *
-   * @param lineIndex This parameter specifies the indentation value that this
-   *                  function compares to the current indentation.
-   *
-   * @retval true If the function added an indentation value
-   *         false Otherwise
-   */
-  bool addIndentation(size_t const column);
-
-  /**
-   * @brief This function checks if the lexer needs to scan additional tokens.
-   *
-   * @retval true If the lexer should fetch additional tokens
-   *         false Otherwise
-   */
-  bool needMoreTokens() const;
-
-  /**
-   * @brief This method adds new tokens to the token stream.
-   */
-  void fetchTokens();
-
-  /**
-   * @brief This method consumes characters from the input stream keeping
-   *        track of line and column numbers.
-   *
-   * @param characters This parameter specifies the number of characters the
-   *                   the function should consume.
-   */
-  void forward(size_t const characters);
-
-  /**
-   * @brief This method removes uninteresting characters from the input.
-   */
-  void scanToNextToken();
-
-  /**
-   * @brief This method checks if the input at the specified offset starts a key
-   *        value token.
-   *
-   * @param offset This parameter specifies an offset to the current position,
-   *               where this function will look for a key value token.
-   *
-   * @retval true If the input matches a key value token
-   *         false Otherwise
-   */
-  bool isValue(size_t const offset = 1) const;
-
-  /**
-   * @brief This method checks if the current input starts a list element.
-   *
-   * @retval true If the input matches a list element token
-   *         false Otherwise
-   */
-  bool isElement() const;
-
-  /**
-   * @brief This method checks if the input at the specified offset starts a
-   *        line comment.
-   *
-   * @param offset This parameter specifies an offset to the current position,
-   *               where this function will look for a comment token.
-   *
-   * @retval true If the input matches a comment token
-   *         false Otherwise
-   */
-  bool isComment(size_t const offset) const;
-
-  /**
-   * @brief This method saves a token for a simple key candidate located at the
-   *        current input position.
-   */
-  void addSimpleKeyCandidate();
-
-  /**
-   * @brief This method adds block closing tokens to the token queue, if the
-   *        indentation decreased.
-   *
-   * @param lineIndex This parameter specifies the column (indentation in number
-   *                  of spaces) for which this method should add block end
-   *                  tokens.
-   */
-  void addBlockEnd(size_t const lineIndex);
-
-  /**
-   * @brief This method adds the token for the start of the YAML stream to
-   *        `tokens`.
-   */
-  void scanStart();
-
-  /**
-   * @brief This method adds the end markers to the token queue.
-   */
-  void scanEnd();
-
-  /**
-   * @brief This method scans a single quoted scalar and adds it to the token
-   *        queue.
-   */
-  void scanSingleQuotedScalar();
-
-  /**
-   * @brief This method scans a plain scalar and adds it to the token queue.
-   */
-  void scanPlainScalar();
-
-  /**
-   * @brief This method counts the number of non space characters that can be
-   *        part of a plain scalar at position `offset`.
-   *
-   * @param offset This parameter specifies an offset to the current input
-   *               position, where this function searches for non space
-   *               characters.
-   *
-   * @return The number of non-space characters at the input position `offset`
-   */
-  size_t countPlainNonSpace(size_t const offset) const;
-
-  /**
-   * @brief This method counts the number of space characters that can be part
-   *        of a plain scalar at the current input position.
-   *
-   * @return The number of space characters at the current input position
-   */
-  size_t countPlainSpace() const;
-
-  /**
-   * @brief This method scans a comment and adds it to the token queue.
-   */
-  void scanComment();
+  /** This variable stores the configuration shared by both cores. */
+  LexerSettings settings;
 
-  /**
-   * @brief This method scans a double quoted scalar and adds it to the token
-   *        queue.
-   */
-  void scanDoubleQuotedScalar();
+  /** This core scans inputs stored in a single buffer. */
+  LexerCore<BufferInput> bufferCore{this, settings};
 
-  /**
-   * @brief This method scans a mapping value token and adds it to the token
-   *        queue.
-   */
-  void scanValue();
+  /** This core scans all other inputs. */
+  LexerCore<StreamInput> streamCore{this, settings};
 
-  /**
-   * @brief This method scans a list element token and adds it to the token
-   *        queue.
-   */
-  void scanElement();
+  /** This boolean specifies if `bufferCore` scans the current input. */
+  bool buffered = false;
 
 public:
   /** This token type starts the YAML stream. */
@@ -310,6 +80,16 @@ public:
   static const size_t COMMENT = 11;
   /** This token type specifies that the token stores a single quoted scalar. */
   static const size_t SINGLE_QUOTED_SCALAR = 12;
+  /** This token type specifies that the token stores an anchor (`&name`). */
+  static const size_t ANCHOR = 13;
+  /** This token type specifies that the token stores an alias (`*name`). */
+  static const size_t ALIAS = 14;
+
+  /**
+   * This channel stores comments that follow other data on the same line, if
+   * the lexer preserves comments.
+   */
+  static const size_t TRAILING_COMMENT_CHANNEL = 2;
 
   /**
    * @brief This constructor creates a new YAML lexer for the given input.
@@ -318,6 +98,14 @@ public:
    */
   YAMLLexer(CharStream *input);
 
+  /**
+   * @brief This method resets the state of the lexer, so it can scan a new
+   *        input.
+   *
+   * @param input This character stream stores the data this lexer scans.
+   */
+  void reset(CharStream *input);
+
   /**
    * @brief This method retrieves the current (not already emitted) token
    *        produced by the lexer.
@@ -361,7 +149,40 @@ public:
    * @param tokenFactory This parameter specifies the factory that the scanner
    *                     should use to create tokens.
    */
-  template <typename T1> void setTokenFactory(TokenFactory<T1> *tokenFactory);
+  void setTokenFactory(Ref<TokenFactory<CommonToken>> const &tokenFactory);
+
+  /**
+   * @brief This method restricts the lexer to the given keys.
+   *
+   * The lexer skips all data that does not belong to a requested key, and it
+   * stops as soon as it read all requested keys. Skipped data does not
+   * produce tokens and the lexer does not check its syntax.
+   *
+   * @param keys This parameter stores the requested keys or `nullptr`, if the
+   *             lexer should scan the whole input.
+   */
+  void setSelection(shared_ptr<Selection> const &keys);
+
+  /**
+   * @brief This method specifies how the lexer handles comments.
+   *
+   * The grammar does not accept comment tokens, so the lexer always keeps
+   * them off the default channel. Dropping comments is the fastest option,
+   * since the lexer does not create any tokens for them.
+   *
+   * @param mode This parameter specifies the new comment mode.
+   */
+  void setCommentMode(CommentMode const mode);
+
+  /**
+   * @brief This method specifies the resource limits for a single document.
+   *
+   * The lexer checks the nesting depth, the length of the token queue, the
+   * size of scalars and the deadline.
+   *
+   * @param documentLimits This parameter stores the new limits.
+   */
+  void setLimits(Limits const &documentLimits);
 
   /**
    * @brief Retrieve the current token factory.
@@ -370,3 +191,5 @@ public:
    */
   Ref<TokenFactory<CommonToken>> getTokenFactory() override;
 };
+
+#endif // YANLR_YAML_LEXER_HPP
@@ -2,26 +2,40 @@
 
 #include <fstream>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 #include <antlr4-runtime.h>
 #include <kdb.hpp>
 
 #include "YAML.h"
 
+#include "Decompressor.hpp"
+#include "Diff.hpp"
+#include "Emitter.hpp"
 #include "ErrorListener.hpp"
 #include "Listener.hpp"
+#include "Parser.hpp"
+#include "Selection.hpp"
+#include "StreamInputStream.hpp"
+#include "UTF8InputStream.hpp"
 #include "YAMLLexer.hpp"
 
 using std::cerr;
 using std::cout;
 using std::endl;
 using std::ifstream;
+using std::make_shared;
 using std::stringstream;
 
 using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
 using ckdb::keyNew;
 
-using antlr4::ANTLRInputStream;
+using antlr4::CharStream;
 using antlr4::CommonTokenStream;
+using antlr4::IllegalArgumentException;
+using antlr4::RuntimeException;
 using ParseTree = antlr4::tree::ParseTree;
 using ParseTreeWalker = antlr4::tree::ParseTreeWalker;
 
@@ -43,49 +57,377 @@ void printTree(ParseTree *tree) {
   cout << tree->toStringTree() << endl << endl;
 }
 
-void printOutput(KeyListener &listener) {
+void printOutput(CppKeySet const &keys) {
   cout << "— Output ————" << endl << endl;
-  for (auto key : listener.keySet()) {
+  for (auto key : keys) {
     cout << key.getName() << ":"
          << (key.getStringSize() > 1 ? " " + key.getString() : "") << endl;
   }
 }
 
+/**
+ * @brief This function reads the content of the given file.
+ *
+ * @param filename This parameter specifies the location of the file. The name
+ *                 `-` stands for `stdin`. The function decompresses gzip and
+ *                 Zstandard data.
+ * @param text This parameter stores the content of the file after the call.
+ *
+ * @retval true If the function was able to read the file
+ *         false Otherwise
+ */
+bool readFile(string const &filename, string &text) {
+  int descriptor = STDIN_FILENO;
+  if (filename != "-") {
+    descriptor = open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      cerr << "Unable to open file “" << filename << "”" << endl;
+      return false;
+    }
+  }
+
+  bool success = true;
+  text.clear();
+  try {
+    Decompressor input{descriptor, filename};
+    char data[64 * 1024];
+    while (size_t const bytes = input.read(data, sizeof(data))) {
+      text.append(data, bytes);
+    }
+  } catch (RuntimeException const &error) {
+    cerr << error.what() << endl;
+    success = false;
+  }
+  if (descriptor != STDIN_FILENO) {
+    close(descriptor);
+  }
+  return success;
+}
+
+/**
+ * @brief This function checks if the given file stores compressed data.
+ *
+ * @param filename This parameter specifies the location of the file.
+ *
+ * @retval true If the file starts with the magic bytes of a compression
+ *              format
+ *         false Otherwise
+ */
+bool isCompressed(string const &filename) {
+  ifstream file{filename, std::ios::binary};
+  char magic[4];
+  file.read(magic, sizeof(magic));
+  return Decompressor::detect(string(magic, file.gcount())) !=
+         Compression::NONE;
+}
+
+/**
+ * @brief This function prints a key in the same format as `printOutput`.
+ *
+ * @param prefix This character specifies if the key was added or removed.
+ * @param name This parameter stores the name of the key.
+ * @param value This parameter stores the value of the key.
+ */
+void printChange(char const prefix, string const &name, string const &value) {
+  cout << prefix << name << ":" << (value.empty() ? "" : " " + value) << "\n";
+}
+
+/**
+ * @brief This function prints the keys that differ between two files.
+ *
+ * Removed keys start with `-`, added keys with `+`. A changed key shows up
+ * as removed key with the old value followed by an added key with the new
+ * value.
+ *
+ * @param before This parameter specifies the file containing the old data.
+ * @param after This parameter specifies the file containing the new data.
+ *
+ * @return `0`, if the files store the same keys, `1`, if they differ, or `2`,
+ *         if one of the files is invalid (like `diff`)
+ */
+int diffFiles(string const &before, string const &after) {
+  Parser parser{};
+  string text;
+  KeyTree oldTree{"user"};
+  KeyTree newTree{"user"};
+  try {
+    if (!readFile(before, text)) {
+      return 2;
+    }
+    oldTree = parser.parseKeyTree(move(text), "user");
+    if (!readFile(after, text)) {
+      return 2;
+    }
+    newTree = parser.parseKeyTree(move(text), "user");
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to parse input: " << error.what() << endl;
+    return 2;
+  }
+
+  size_t changes =
+      diff(oldTree, newTree,
+           [](Change const change, string const &name, string const &oldValue,
+              string const &newValue) {
+             if (change != Change::ADDED) {
+               printChange('-', name, oldValue);
+             }
+             if (change != Change::REMOVED) {
+               printChange('+', name, newValue);
+             }
+           });
+  cout.flush();
+  return changes > 0 ? 1 : 0;
+}
+
+/**
+ * @brief This function checks the syntax of the given files.
+ *
+ * @param filenames This parameter stores the names of the checked files. The
+ *                  name `-` stands for `stdin`.
+ *
+ * @return `EXIT_SUCCESS`, if all files store valid YAML data or
+ *         `EXIT_FAILURE` otherwise
+ */
+int checkFiles(vector<string> const &filenames) {
+  Parser parser{};
+  int status = EXIT_SUCCESS;
+  string text;
+  for (auto const &filename : filenames) {
+    if (!readFile(filename, text)) {
+      status = EXIT_FAILURE;
+      continue;
+    }
+
+    for (auto const &diagnostic : parser.check(move(text))) {
+      cerr << filename << ":" << diagnostic << endl;
+      status = EXIT_FAILURE;
+    }
+  }
+  return status;
+}
+
+/**
+ * @brief This function converts the given file to JSON.
+ *
+ * @param filename This parameter specifies the name of the converted file.
+ *                 The name `-` stands for `stdin`.
+ *
+ * @return `EXIT_SUCCESS`, if the file stores valid YAML data or
+ *         `EXIT_FAILURE` otherwise
+ */
+int convertToJSON(string const &filename) {
+  string text;
+  if (!readFile(filename, text)) {
+    return EXIT_FAILURE;
+  }
+
+  Parser parser{};
+  try {
+    parser.toJSON(move(text), cout);
+  } catch (RuntimeException const &error) {
+    cout.flush();
+    cerr << "Unable to parse “" << filename << "”: " << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+  cout.flush();
+  return EXIT_SUCCESS;
+}
+
+/**
+ * @brief This function merges the given files and prints the result as YAML.
+ *
+ * @param filenames This parameter stores the names of the layers, starting
+ *                  with the base layer. Each layer overrides the data of the
+ *                  layers before it. The name `-` stands for `stdin`.
+ *
+ * @return `EXIT_SUCCESS`, if all files store valid YAML data or
+ *         `EXIT_FAILURE` otherwise
+ */
+int overlayFiles(vector<string> const &filenames) {
+  Parser parser{};
+  CppKey const parent{"user", KEY_END};
+  parser.resetLayers(parent);
+  string text;
+  for (auto const &filename : filenames) {
+    if (!readFile(filename, text)) {
+      return EXIT_FAILURE;
+    }
+    try {
+      parser.addLayer(move(text));
+    } catch (RuntimeException const &error) {
+      cerr << "Unable to parse “" << filename << "”: " << error.what() << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  try {
+    emit(parser.layers(), parent, cout);
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to write the merged data: " << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+  cout.flush();
+  return EXIT_SUCCESS;
+}
+
 // -- Main ---------------------------------------------------------------------
 
 int main(int argc, char const *argv[]) {
+  spdlog::set_pattern("[%H:%M:%S:%e] %v ");
 
-  if (argc < 2) {
-    cerr << "Usage: " << argv[0] << " filename" << endl;
-    return EXIT_FAILURE;
+  string const usage = string{"Usage: "} + argv[0] +
+                       " [--select name]... [filename|-]\n       " + argv[0] +
+                       " --check [filename|-]...\n       " + argv[0] +
+                       " --json [filename|-]\n       " + argv[0] +
+                       " --overlay [filename|-]...\n       " + argv[0] +
+                       " diff before after";
+  CppKey parent{keyNew("user", KEY_END, "", KEY_VALUE)};
+
+  if (argc > 1 && string{argv[1]} == "diff") {
+    if (argc != 4) {
+      cerr << usage << endl;
+      return 2;
+    }
+    return diffFiles(argv[2], argv[3]);
+  }
+
+  // Each `--select` option restricts the output to the given key and the keys
+  // below it. The option `--check` only reports syntax errors, but accepts
+  // multiple files. The option `--json` prints the input as JSON. The option
+  // `--overlay` merges multiple files, where later files override earlier
+  // ones, and prints the result as YAML.
+  vector<string> names;
+  vector<string> filenames;
+  bool check = false;
+  bool json = false;
+  bool overlay = false;
+  for (int argument = 1; argument < argc; argument++) {
+    string const option{argv[argument]};
+    if (option == "--select" && argument + 1 < argc) {
+      names.push_back(argv[++argument]);
+    } else if (option == "--check") {
+      check = true;
+    } else if (option == "--json") {
+      json = true;
+    } else if (option == "--overlay") {
+      overlay = true;
+    } else if (option == "--select") {
+      cerr << usage << endl;
+      return EXIT_FAILURE;
+    } else {
+      filenames.push_back(option);
+    }
+  }
+  if (filenames.empty()) {
+    filenames.push_back("-");
   }
 
-  ifstream file{argv[1]};
-  if (!file.is_open()) {
-    cerr << "Unable to open file “" << argv[1] << "”" << endl;
+  if (check && !json && !overlay && names.empty()) {
+    return checkFiles(filenames);
+  }
+  if (overlay && !check && !json && names.empty()) {
+    return overlayFiles(filenames);
+  }
+  if (check || overlay || filenames.size() > 1 || (json && !names.empty())) {
+    cerr << usage << endl;
     return EXIT_FAILURE;
   }
+  if (json) {
+    return convertToJSON(filenames.front());
+  }
+
+  // Only the default mode shows the trace output of the lexer. The other modes
+  // write diagnostics or data for other programs.
+  spdlog::set_level(spdlog::level::trace);
+  string const filename = filenames.front();
+
+  shared_ptr<Selection> selection;
+  if (!names.empty()) {
+    try {
+      selection = make_shared<Selection>(parent, names);
+    } catch (IllegalArgumentException const &error) {
+      cerr << error.what() << endl;
+      return EXIT_FAILURE;
+    }
+  }
 
-  stringstream text;
-  text << file.rdbuf();
-  cout << "— Input ———————" << endl << endl << text.str() << endl;
-  ANTLRInputStream input(text.str());
-  YAMLLexer lexer(&input);
+  // Without a filename (or with `-`) we parse the data from `stdin` as it
+  // arrives. We also stream compressed files, so their uncompressed data
+  // never has to fit into memory as a whole.
+  bool const streaming = filename == "-" || isCompressed(filename);
+  unique_ptr<CharStream> input;
+
+  if (streaming) {
+    // The descriptor stays open until the program exits
+    int const descriptor =
+        filename == "-" ? STDIN_FILENO : open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+      cerr << "Unable to open file “" << filename << "”" << endl;
+      return EXIT_FAILURE;
+    }
+    try {
+      input.reset(new StreamInputStream{
+          descriptor, filename == "-" ? "stdin" : filename});
+    } catch (RuntimeException const &error) {
+      cerr << error.what() << endl;
+      return EXIT_FAILURE;
+    }
+  } else {
+    ifstream file{filename};
+    if (!file.is_open()) {
+      cerr << "Unable to open file “" << filename << "”" << endl;
+      cerr << usage << endl;
+      return EXIT_FAILURE;
+    }
+
+    stringstream text;
+    text << file.rdbuf();
+    cout << "— Input ———————" << endl << endl << text.str() << endl;
+    try {
+      input.reset(new UTF8InputStream{text.str(), filename});
+    } catch (IllegalArgumentException const &error) {
+      cerr << "Unable to read file “" << filename << "”: " << error.what()
+           << endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  YAMLLexer lexer(input.get());
+  lexer.setSelection(selection);
+  if (streaming) {
+    // The stream drops data the lexer already consumed. We therefore store
+    // the text of each token as soon as the lexer creates it.
+    lexer.setTokenFactory(make_shared<PositionTokenFactory>(true));
+  }
   CommonTokenStream tokens(&lexer);
-  printTokens(tokens);
+  if (!streaming) {
+    // Printing all tokens requires the lexer to read the whole input first
+    printTokens(tokens);
+  }
 
   YAML parser(&tokens);
   ErrorListener errorListener{};
   parser.removeErrorListeners();
   parser.addErrorListener(&errorListener);
 
-  ParseTree *tree = parser.yaml();
+  ParseTree *tree;
+  try {
+    tree = parser.yaml();
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to parse “" << input->getSourceName()
+         << "”: " << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+  for (auto const &error : errorListener.errors()) {
+    cerr << error << endl;
+  }
   printTree(tree);
 
   ParseTreeWalker walker{};
-  KeyListener listener{keyNew("user", KEY_END, "", KEY_VALUE)};
+  KeyListener listener{parent};
   walker.walk(&listener, tree);
-  printOutput(listener);
+  printOutput(selection ? selection->filter(listener.keySet())
+                        : listener.keySet());
 
   return parser.getNumberOfSyntaxErrors();
 }
@@ -0,0 +1,89 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::to_string;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a document, where each level contains ten
+ *        aliases of the level before (“billion laughs”).
+ *
+ * @param levels This parameter specifies the number of levels.
+ *
+ * @return A document that expands to 10^`levels` keys
+ */
+string laughs(size_t const levels) {
+  string text = "level0: &level0 lol\n";
+  for (size_t level = 1; level <= levels; level++) {
+    string const name = "level" + to_string(level);
+    text += name + ": &" + name + "\n";
+    for (size_t alias = 0; alias < 10; alias++) {
+      text += "  - *level" + to_string(level - 1) + "\n";
+    }
+  }
+  return text;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  Parser parser{};
+  Limits limits;
+  limits.aliasKeys = 100000;
+  parser.setLimits(limits);
+  bool failed = false;
+
+  // Each parsing method has to stop the expansion
+  for (size_t method = 0; method < 2; method++) {
+    string const name = method == 0 ? "parse" : "parseKeyTree";
+    try {
+      if (method == 0) {
+        parser.parse(laughs(9), CppKey{"user", KEY_END});
+      } else {
+        parser.parseKeyTree(laughs(9), "user");
+      }
+      cerr << "“" << name << "” did not enforce the alias limit" << endl;
+      failed = true;
+    } catch (RuntimeException const &error) {
+      if (string{error.what()}.find("limit") == string::npos) {
+        cerr << "“" << name << "” failed with unexpected error: "
+             << error.what() << endl;
+        failed = true;
+      }
+    }
+  }
+
+  // Documents below the limit expand completely
+  try {
+    auto keys = parser.parse(laughs(3), CppKey{"user", KEY_END});
+    if (!keys.lookup("user/level3/#9/#9/#9") ||
+        keys.lookup("user/level3/#9/#9/#9").getString() != "lol") {
+      cerr << "Missing expanded key “user/level3/#9/#9/#9”" << endl;
+      failed = true;
+    }
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to parse input: " << error.what() << endl;
+    failed = true;
+  }
+
+  try {
+    parser.parse("key: *missing\n", CppKey{"user", KEY_END});
+    cerr << "Parsing an unknown alias did not fail" << endl;
+    failed = true;
+  } catch (RuntimeException const &error) {
+    if (string{error.what()}.find("Unknown alias “missing”") == string::npos) {
+      cerr << "Unexpected error for unknown alias: " << error.what() << endl;
+      failed = true;
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
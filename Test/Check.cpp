@@ -0,0 +1,51 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  struct {
+    string text;
+    bool valid;
+  } const cases[] = {
+      {"", true},
+      {"key: value # comment\nlist:\n  - 1\n  - 2\n", true},
+      {"anchor: &a\n  key: value\nalias: *a\n", true},
+      {"key: value\n- element\n", false},
+      {"key: 'unterminated\n", false},
+      {"key: \xff\n", false},
+  };
+
+  Parser parser{};
+  parser.setCommentMode(CommentMode::PRESERVE);
+  bool failed = false;
+  for (auto const &test : cases) {
+    auto diagnostics = parser.check(test.text);
+    if (diagnostics.empty() != test.valid) {
+      cerr << "Checking" << endl
+           << test.text << "returned " << diagnostics.size() << " errors"
+           << endl;
+      for (auto const &diagnostic : diagnostics) {
+        cerr << diagnostic << endl;
+      }
+      failed = true;
+    }
+  }
+
+  // Checking must not change the behavior of the other parsing methods
+  auto keys = parser.parse("key: value # comment\n", CppKey{"user", KEY_END});
+  auto key = keys.lookup("user/key");
+  if (!key || key.getString() != "value" ||
+      key.getMeta<string>("comment/#0") != " comment") {
+    cerr << "Parsing after a check did not return the expected keys" << endl;
+    failed = true;
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Conversion.hpp"
+#include "Corpus.hpp"
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+using antlr4::RuntimeException;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  string const text = "# Header\n"
+                      "server:       # Server settings\n"
+                      "  host: example.com # Trailing\n"
+                      "# Unindented comment inside the mapping\n"
+                      "  port: 80\n"
+                      "list:\n"
+                      "  # First element\n"
+                      "  - one\n"
+                      "  - two # Second element\n"
+                      "# Footer\n";
+  string const expected = "user/list:\n"
+                          "user/list/#0: one\n"
+                          "user/list/#1: two\n"
+                          "user/server/host: example.com\n"
+                          "user/server/port: 80\n";
+
+  struct {
+    string name;
+    vector<string> comments;
+  } const metadata[] = {
+      {"user/server", {" Header", " Server settings"}},
+      {"user/server/host", {" Trailing"}},
+      {"user/server/port", {" Unindented comment inside the mapping"}},
+      {"user/list", {}},
+      {"user/list/#0", {" First element"}},
+      {"user/list/#1", {" Second element", " Footer"}},
+  };
+
+  Parser parser{};
+  bool failed = false;
+
+  // Comments must not change the data, regardless of the comment mode
+  for (auto mode : {CommentMode::DROP, CommentMode::HIDDEN}) {
+    parser.setCommentMode(mode);
+    string actual;
+    try {
+      actual = toString(parser.parse(text, CppKey{"user", KEY_END}));
+    } catch (RuntimeException const &error) {
+      actual = error.what();
+    }
+    if (actual != expected) {
+      cerr << "Parsing returned" << endl
+           << actual << "instead of" << endl
+           << expected << endl;
+      failed = true;
+    }
+  }
+
+  parser.setCommentMode(CommentMode::PRESERVE);
+  CppKeySet keys;
+  try {
+    keys = parser.parse(text, CppKey{"user", KEY_END});
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to parse input: " << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  for (auto const &key : metadata) {
+    CppKey found = keys.lookup(key.name);
+    if (!found) {
+      cerr << "Missing key “" << key.name << "”" << endl;
+      failed = true;
+      continue;
+    }
+    for (uintmax_t index = 0; index <= key.comments.size(); index++) {
+      string const name = "comment/" + indexToArrayBaseName(index);
+      if (index == key.comments.size()) {
+        if (found.hasMeta(name)) {
+          cerr << "Unexpected comment “" << found.getMeta<string>(name)
+               << "” for “" << key.name << "”" << endl;
+          failed = true;
+        }
+      } else if (!found.hasMeta(name) ||
+                 found.getMeta<string>(name) != key.comments[index]) {
+        cerr << "Expected comment “" << key.comments[index] << "” for “"
+             << key.name << "”, but found “" << found.getMeta<string>(name)
+             << "”" << endl;
+        failed = true;
+      }
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
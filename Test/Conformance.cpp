@@ -0,0 +1,110 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "Corpus.hpp"
+#include "Parser.hpp"
+
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::max;
+using std::min;
+using std::vector;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using std::chrono::steady_clock;
+
+using antlr4::RuntimeException;
+
+// -- Main ---------------------------------------------------------------------
+
+/*
+ * Usage: conformance [--repeat count] directory...
+ *
+ * Each directory contains test cases in the layout of `Input`: The file
+ * `name.yaml` stores the input and `name.txt` stores the expected output of
+ * `badger`. Instead of `name.txt`, a case can provide a file `name.error`,
+ * if parsing the input should fail. The runner skips cases without expected
+ * result. With `--repeat` the runner parses each input multiple times and
+ * reports the fastest run.
+ */
+int main(int argc, char const *argv[]) {
+  size_t repeat = 1;
+  vector<string> directories;
+  for (int argument = 1; argument < argc; argument++) {
+    if (string{argv[argument]} == "--repeat" && argument + 1 < argc) {
+      repeat = max(std::stoul(argv[++argument]), 1UL);
+    } else {
+      directories.push_back(argv[argument]);
+    }
+  }
+  if (directories.empty()) {
+    cerr << "Usage: " << argv[0] << " [--repeat count] directory..." << endl;
+    return EXIT_FAILURE;
+  }
+
+  Parser parser{};
+  CppKey const parent{"user", KEY_END};
+  size_t passed = 0, failed = 0, skipped = 0, bytes = 0;
+  microseconds total{0};
+
+  for (auto const &directory : directories) {
+    for (auto const &file : listYAMLFiles(directory)) {
+      string const base = file.substr(0, file.size() - string{".yaml"}.size());
+      string input, expected, error;
+      bool const expectError = readFile(base + ".error", error);
+      if (!readFile(base + ".yaml", input) ||
+          (!readFile(base + ".txt", expected) && !expectError)) {
+        cout << "- " << base << " (no expected output)" << endl;
+        skipped++;
+        continue;
+      }
+
+      string actual;
+      bool parsed = true;
+      microseconds fastest = microseconds::max();
+      for (size_t run = 0; run < repeat; run++) {
+        auto const start = steady_clock::now();
+        try {
+          actual = toString(parser.parse(input, parent));
+        } catch (RuntimeException const &exception) {
+          actual = exception.what();
+          parsed = false;
+        }
+        fastest = min(fastest, duration_cast<microseconds>(
+                                   steady_clock::now() - start));
+      }
+      total += fastest;
+      bytes += input.size();
+
+      if (expectError ? !parsed : parsed && actual == expected) {
+        cout << "✓ " << base << " (" << fastest.count() << " µs)" << endl;
+        passed++;
+        continue;
+      }
+      cout << "✗ " << base << " (" << fastest.count() << " µs)" << endl;
+      cerr << endl
+           << "The output for “" << base << ".yaml” did not match the "
+           << (expectError ? "expected error" : "expected output") << ":"
+           << endl
+           << endl
+           << actual << (expectError ? "" : "\ninstead of\n\n" + expected)
+           << endl;
+      failed++;
+    }
+  }
+
+  cout << endl
+       << passed << " passed, " << failed << " failed, " << skipped
+       << " skipped" << endl
+       << "Parsed " << bytes << " bytes in " << total.count() << " µs";
+  if (total.count() > 0) {
+    cout << " (" << bytes / total.count() << " MB/s)";
+  }
+  cout << endl;
+
+  return failed > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,158 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <dirent.h>
+
+#include "Corpus.hpp"
+
+using std::ifstream;
+using std::sort;
+using std::stringstream;
+using std::to_string;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function checks if a file exists and returns its content.
+ *
+ * @param filename This parameter specifies the location of the file.
+ * @param text This parameter stores the data of the file after the call.
+ *
+ * @retval true If the function was able to read the file
+ *         false Otherwise
+ */
+bool readFile(string const &filename, string &text) {
+  ifstream file{filename};
+  if (!file.is_open()) {
+    return false;
+  }
+  stringstream content;
+  content << file.rdbuf();
+  text = content.str();
+  return true;
+}
+
+/**
+ * @brief This function returns the content of the given file.
+ *
+ * @param filename This parameter specifies the location of the file.
+ *
+ * @return The data stored in the file, or an empty string if the file does
+ *         not exist
+ */
+string readFile(string const &filename) {
+  string text;
+  readFile(filename, text);
+  return text;
+}
+
+/**
+ * @brief This function returns the paths of all YAML files stored in the
+ *        given directory.
+ *
+ * @param path This parameter specifies a directory.
+ *
+ * @return A sorted list of all files with the extension `.yaml` in `path`
+ */
+vector<string> listYAMLFiles(string const &path) {
+  vector<string> files;
+  DIR *directory = opendir(path.c_str());
+  if (directory == nullptr) {
+    return files;
+  }
+
+  string const extension = ".yaml";
+  while (dirent *entry = readdir(directory)) {
+    string name = entry->d_name;
+    if (name.size() > extension.size() &&
+        name.compare(name.size() - extension.size(), extension.size(),
+                     extension) == 0) {
+      files.push_back(path + "/" + name);
+    }
+  }
+  closedir(directory);
+  sort(files.begin(), files.end());
+  return files;
+}
+
+/**
+ * @brief This function returns the content of all YAML files stored in the
+ *        given directory.
+ *
+ * @param path This parameter specifies a directory.
+ *
+ * @return The data of all files with the extension `.yaml` in `path`
+ */
+vector<string> readYAMLFiles(string const &path) {
+  vector<string> texts;
+  for (auto const &file : listYAMLFiles(path)) {
+    texts.push_back(readFile(file));
+  }
+  return texts;
+}
+
+/**
+ * @brief This function converts a key set to the output format of `badger`.
+ *
+ * @param keys This parameter stores the key set this function converts.
+ * @param comments This parameter specifies if the output contains the
+ *                 comment metadata (`comment/#n`) of each key.
+ *
+ * @return A string containing the name and value (and comments) of every key
+ *         in `keys`
+ */
+string toString(CppKeySet const &keys, bool const comments) {
+  string text;
+  for (CppKey const &key : keys) {
+    text += key.getName() + ":" +
+            (key.getStringSize() > 1 ? " " + key.getString() : "") + "\n";
+    for (size_t index = 0;
+         comments && key.hasMeta("comment/#" + to_string(index)); index++) {
+      text += "  #" + key.getMeta<string>("comment/#" + to_string(index)) +
+              "\n";
+    }
+  }
+  return text;
+}
+
+/**
+ * @brief This function checks if two key sets store the same keys, values and
+ *        metadata.
+ *
+ * @param expected This parameter stores the reference key set.
+ * @param actual This parameter stores the checked key set.
+ * @param metadata This parameter stores the names of the compared metadata.
+ *
+ * @return An empty string, if both key sets are equal, or a description of
+ *         the first difference otherwise
+ */
+string compare(CppKeySet const &expected, CppKeySet const &actual,
+               vector<string> const &metadata) {
+  if (expected.size() != actual.size()) {
+    return "Expected " + to_string(expected.size()) + " keys, got " +
+           to_string(actual.size());
+  }
+  for (CppKey const &key : expected) {
+    CppKey other = actual.lookup(key.getName());
+    if (!other) {
+      return "Missing key “" + key.getName() + "”";
+    }
+    if (key.isBinary() != other.isBinary() ||
+        key.getStringSize() != other.getStringSize() ||
+        (key.getStringSize() > 0 &&
+         (key.isBinary() ? key.getBinary() != other.getBinary()
+                         : key.getString() != other.getString()))) {
+      return "Value of key “" + key.getName() + "” differs";
+    }
+    for (auto const &name : metadata) {
+      if (key.getMeta<string>(name) != other.getMeta<string>(name)) {
+        return "Metadata “" + name + "” of key “" + key.getName() +
+               "” differs";
+      }
+    }
+  }
+  return "";
+}
@@ -0,0 +1,86 @@
+#ifndef YANLR_CORPUS_HPP
+#define YANLR_CORPUS_HPP
+
+// -- Imports ------------------------------------------------------------------
+
+#include <string>
+#include <vector>
+
+#include <kdb.hpp>
+
+using std::string;
+using std::vector;
+
+using CppKey = kdb::Key;
+using CppKeySet = kdb::KeySet;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function checks if a file exists and returns its content.
+ *
+ * @param filename This parameter specifies the location of the file.
+ * @param text This parameter stores the data of the file after the call.
+ *
+ * @retval true If the function was able to read the file
+ *         false Otherwise
+ */
+bool readFile(string const &filename, string &text);
+
+/**
+ * @brief This function returns the content of the given file.
+ *
+ * @param filename This parameter specifies the location of the file.
+ *
+ * @return The data stored in the file, or an empty string if the file does
+ *         not exist
+ */
+string readFile(string const &filename);
+
+/**
+ * @brief This function returns the paths of all YAML files stored in the
+ *        given directory.
+ *
+ * @param path This parameter specifies a directory.
+ *
+ * @return A sorted list of all files with the extension `.yaml` in `path`
+ */
+vector<string> listYAMLFiles(string const &path);
+
+/**
+ * @brief This function returns the content of all YAML files stored in the
+ *        given directory.
+ *
+ * @param path This parameter specifies a directory.
+ *
+ * @return The data of all files with the extension `.yaml` in `path`
+ */
+vector<string> readYAMLFiles(string const &path);
+
+/**
+ * @brief This function converts a key set to the output format of `badger`.
+ *
+ * @param keys This parameter stores the key set this function converts.
+ * @param comments This parameter specifies if the output contains the
+ *                 comment metadata (`comment/#n`) of each key.
+ *
+ * @return A string containing the name and value (and comments) of every key
+ *         in `keys`
+ */
+string toString(CppKeySet const &keys, bool const comments = false);
+
+/**
+ * @brief This function checks if two key sets store the same keys, values and
+ *        metadata.
+ *
+ * @param expected This parameter stores the reference key set.
+ * @param actual This parameter stores the checked key set.
+ * @param metadata This parameter stores the names of the compared metadata.
+ *
+ * @return An empty string, if both key sets are equal, or a description of
+ *         the first difference otherwise
+ */
+string compare(CppKeySet const &expected, CppKeySet const &actual,
+               vector<string> const &metadata);
+
+#endif // YANLR_CORPUS_HPP
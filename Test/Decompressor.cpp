@@ -0,0 +1,167 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdio>
+#include <iostream>
+
+#include <zlib.h>
+#ifdef HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "StreamInputStream.hpp"
+
+using std::cerr;
+using std::endl;
+using std::to_string;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function compresses data as a single gzip member.
+ *
+ * @param data This parameter stores the uncompressed data.
+ *
+ * @return The gzip data for `data`
+ */
+string gzip(string const &data) {
+  z_stream stream{};
+  deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + MAX_WBITS, 8,
+               Z_DEFAULT_STRATEGY);
+  string compressed(deflateBound(&stream, data.size()), '\0');
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data.data()));
+  stream.avail_in = data.size();
+  stream.next_out = reinterpret_cast<Bytef *>(&compressed[0]);
+  stream.avail_out = compressed.size();
+  deflate(&stream, Z_FINISH);
+  compressed.resize(stream.total_out);
+  deflateEnd(&stream);
+  return compressed;
+}
+
+/**
+ * @brief This function stores data in a temporary file.
+ *
+ * @param data This parameter stores the content of the file.
+ *
+ * @return A file positioned at the start of `data`, which the system removes
+ *         after the caller closed it
+ */
+FILE *temporaryFile(string const &data) {
+  FILE *file = tmpfile();
+  fwrite(data.data(), 1, data.size(), file);
+  fflush(file);
+  rewind(file);
+  return file;
+}
+
+/**
+ * @brief This function reads the given data via a decompressor.
+ *
+ * @param data This parameter stores the (compressed) input.
+ *
+ * @throws RuntimeException If the decompressor failed
+ *
+ * @return The data returned by the decompressor
+ */
+string decompressed(string const &data) {
+  FILE *file = temporaryFile(data);
+  string text;
+  try {
+    Decompressor input{fileno(file), "test"};
+    char buffer[1000];
+    while (size_t const bytes = input.read(buffer, sizeof(buffer))) {
+      text.append(buffer, bytes);
+    }
+  } catch (RuntimeException const &) {
+    fclose(file);
+    throw;
+  }
+  fclose(file);
+  return text;
+}
+
+/**
+ * @brief This function reads the given data via a character stream.
+ *
+ * @param data This parameter stores the (compressed) input.
+ *
+ * @return The characters returned by the stream
+ */
+string streamed(string const &data) {
+  FILE *file = temporaryFile(data);
+  string text;
+  {
+    StreamInputStream input{fileno(file), "test"};
+    while (input.LA(1) != CharStream::EOF) {
+      text += static_cast<char>(input.LA(1));
+      input.consume();
+    }
+  }
+  fclose(file);
+  return text;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  // The data spans multiple chunks of the decompressor
+  string yaml;
+  for (size_t entry = 0; entry < 50000; entry++) {
+    yaml += "key" + to_string(entry) + ": “value” " + to_string(entry) + "\n";
+  }
+
+  struct {
+    string name;
+    string input;
+    string output;
+  } const cases[] = {
+      {"plain data", yaml, yaml},
+      {"short plain data", "a", "a"},
+      {"empty data", "", ""},
+      {"gzip data", gzip(yaml), yaml},
+      {"empty gzip data", gzip(""), ""},
+      {"multiple gzip members", gzip("a: 1\n") + gzip("b: 2\n"),
+       "a: 1\nb: 2\n"},
+#ifdef HAVE_ZSTD
+      {"Zstandard data", [&yaml]() {
+         string compressed(ZSTD_compressBound(yaml.size()), '\0');
+         compressed.resize(ZSTD_compress(&compressed[0], compressed.size(),
+                                         yaml.data(), yaml.size(), 3));
+         return compressed;
+       }(),
+       yaml},
+#endif
+  };
+
+  bool failed = false;
+  for (auto const &test : cases) {
+    try {
+      if (decompressed(test.input) != test.output ||
+          streamed(test.input) != test.output) {
+        cerr << "Reading " << test.name << " returned wrong data" << endl;
+        failed = true;
+      }
+    } catch (RuntimeException const &error) {
+      cerr << "Reading " << test.name << " failed: " << error.what() << endl;
+      failed = true;
+    }
+  }
+
+  string const compressed = gzip(yaml);
+  for (string const &invalid :
+       {compressed.substr(0, compressed.size() / 2),
+        compressed.substr(0, compressed.size() - 1), string{"\x1f\x8b"},
+        compressed.substr(0, 20) + string(100, 'x')}) {
+    try {
+      decompressed(invalid);
+      cerr << "Reading invalid gzip data of " << invalid.size()
+           << " bytes did not fail" << endl;
+      failed = true;
+    } catch (RuntimeException const &) {
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Diff.hpp"
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  struct {
+    string before;
+    string after;
+    string changes;
+  } const cases[] = {
+      {"key: value\n", "key: value\n", ""},
+      {"key: old\n", "key: new\n", "~user/key: old → new\n"},
+      {"b: 1\na: 2\n", "a: 2\nc: 3\n", "-user/b: 1\n+user/c: 3\n"},
+      {"map:\n  x: 1\n  y: 2\n", "map:\n  y: 2\n  z: 3\n",
+       "-user/map/x: 1\n+user/map/z: 3\n"},
+      {"list:\n  - a\n  - b\n", "list:\n  - a\n  - c\n  - d\n",
+       "~user/list/#1: b → c\n+user/list/#2: d\n"},
+      // Keys that store a mapping are not part of the tree
+      {"key: value\n", "key:\n  nested: value\n",
+       "-user/key: value\n+user/key/nested: value\n"},
+      {"", "key: value\n", "+user/key: value\n"},
+  };
+
+  Parser parser{};
+  bool failed = false;
+  for (auto const &test : cases) {
+    KeyTree before = parser.parseKeyTree(test.before, "user");
+    KeyTree after = parser.parseKeyTree(test.after, "user");
+    string changes;
+    size_t count = diff(before, after,
+                        [&changes](Change const change, string const &name,
+                                   string const &oldValue,
+                                   string const &newValue) {
+                          if (change == Change::ADDED) {
+                            changes += "+" + name + ": " + newValue + "\n";
+                          } else if (change == Change::REMOVED) {
+                            changes += "-" + name + ": " + oldValue + "\n";
+                          } else {
+                            changes += "~" + name + ": " + oldValue + " → " +
+                                       newValue + "\n";
+                          }
+                        });
+    size_t lines = 0;
+    for (char const character : changes) {
+      lines += character == '\n';
+    }
+    if (changes != test.changes || count != lines) {
+      cerr << "Comparing" << endl
+           << test.before << "with" << endl
+           << test.after << "returned" << endl
+           << changes << "instead of" << endl
+           << test.changes << endl;
+      failed = true;
+    }
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,51 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+
+using antlr4::RuntimeException;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  struct {
+    string text;
+    string error;
+  } const cases[] = {
+      {"key: 1\nother: 2\nkey: 3\n",
+       "3:1 Duplicate key “key” (first occurrence at 1:1)"},
+      {"outer:\n  inner: 1\n  'inner': 2\n",
+       "3:3 Duplicate key “inner” (first occurrence at 2:3)"},
+      // Equal keys in different mappings are fine
+      {"one:\n  key: 1\ntwo:\n  key: 2\n", ""},
+      {"- key: 1\n- key: 2\n", ""},
+  };
+
+  Parser parser{};
+  bool failed = false;
+  for (auto const &test : cases) {
+    for (size_t method = 0; method < 2; method++) {
+      string error;
+      try {
+        if (method == 0) {
+          parser.parse(test.text, CppKey{"user", KEY_END});
+        } else {
+          parser.parseKeyTree(test.text, "user");
+        }
+      } catch (RuntimeException const &exception) {
+        error = exception.what();
+      }
+      if (error != test.error) {
+        cerr << "Parsing" << endl
+             << test.text << "returned the error “" << error
+             << "” instead of “" << test.error << "”" << endl;
+        failed = true;
+      }
+    }
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+
+#include "Corpus.hpp"
+#include "Emitter.hpp"
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::ostringstream;
+using std::vector;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function converts a key set to YAML data.
+ *
+ * @param keys This parameter stores the converted keys.
+ * @param resolution This parameter specifies how the parser resolves the
+ *                   type of plain scalars.
+ *
+ * @return The YAML data written by the emitter
+ */
+string emitted(CppKeySet const &keys, TypeResolution const resolution) {
+  ostringstream output;
+  emit(keys, CppKey{"user", KEY_END}, output, resolution);
+  return output.str();
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  if (argc != 2) {
+    cerr << "Usage: " << argv[0] << " directory" << endl;
+    return EXIT_FAILURE;
+  }
+
+  struct {
+    TypeResolution resolution;
+    string yaml;
+    string output;
+  } const cases[] = {
+      {TypeResolution::NONE, "", ""},
+      {TypeResolution::NONE, "scalar\n", "scalar\n"},
+      {TypeResolution::NONE, "key: value\n", "key: value\n"},
+      // The emitter uses the order of the key set
+      {TypeResolution::NONE, "b: 1\na: 2\n", "a: 2\nb: 1\n"},
+      {TypeResolution::NONE, "map:\n  key:\n  list:\n    - a\n    - b\n",
+       "map:\n  key:\n  list:\n    - a\n    - b\n"},
+      {TypeResolution::NONE, "- key: value\n  other: 1\n-\n  - 2\n- x\n",
+       "- key: value\n  other: 1\n-\n  - 2\n- x\n"},
+      {TypeResolution::NONE,
+       "a: 'it''s'\nb: '- x'\nc: 'x: y'\nd: ''\ne: ' x'\nf: \"a:b\"\n"
+       "g: 'x#'\n'&key': '*x'\n",
+       "'&key': '*x'\na: it's\nb: '- x'\nc: 'x: y'\nd: ''\ne: ' x'\nf: a:b\n"
+       "g: 'x#'\n"},
+      {TypeResolution::NONE, "# note\nkey: value # trailing\n",
+       "# note\n# trailing\nkey: value\n"},
+      // Multi-line scalars use double quotes and escape sequences
+      {TypeResolution::NONE, "a: \"x\\ny \\\"z\\\"\"\n",
+       "a: \"x\\ny \\\"z\\\"\"\n"},
+      // Strings that look like other types keep their quotes
+      {TypeResolution::BINARY,
+       "a: 1\nb: 1.0\nc: true\nd: ~\ne: '2'\nf: -.inf\ng: 'true'\nh: '~'\n",
+       "a: 1\nb: 1.0\nc: true\nd: ~\ne: '2'\nf: -.inf\ng: 'true'\nh: '~'\n"},
+      {TypeResolution::METADATA, "a: 1\nb: '1'\n", "a: 1\nb: '1'\n"},
+  };
+
+  // The round trip keeps values, array metadata, types and comments
+  vector<string> const metadata = {"array", "type", "comment/#0",
+                                   "comment/#1"};
+  Parser parser{};
+  parser.setCommentMode(CommentMode::PRESERVE);
+  bool failed = false;
+  for (auto const &test : cases) {
+    parser.setTypeResolution(test.resolution);
+    CppKeySet expected = parser.parse(test.yaml, CppKey{"user", KEY_END});
+    string const output = emitted(expected, test.resolution);
+    string difference = compare(
+        expected, parser.parse(output, CppKey{"user", KEY_END}), metadata);
+    if (output != test.output || !difference.empty()) {
+      cerr << "Emitting" << endl
+           << test.yaml << "returned" << endl
+           << output << "instead of" << endl
+           << test.output << difference << endl;
+      failed = true;
+    }
+  }
+
+  for (auto const resolution :
+       {TypeResolution::NONE, TypeResolution::METADATA,
+        TypeResolution::BINARY}) {
+    parser.setTypeResolution(resolution);
+    for (auto const &filename : listYAMLFiles(argv[1])) {
+      CppKeySet expected =
+          parser.parse(readFile(filename), CppKey{"user", KEY_END});
+      string const output = emitted(expected, resolution);
+      string difference = compare(
+          expected, parser.parse(output, CppKey{"user", KEY_END}), metadata);
+      if (!difference.empty()) {
+        cerr << "“" << filename << "”: " << difference << endl
+             << "Emitted data:" << endl
+             << output;
+        failed = true;
+      }
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
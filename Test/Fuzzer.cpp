@@ -0,0 +1,252 @@
+/*
+ * This file contains a fuzz target for the whole parsing process (lexer,
+ * grammar parser and key listener).
+ *
+ * - If you compile the file with `-fsanitize=fuzzer`, then libFuzzer
+ *   provides the `main` function.
+ * - Otherwise (`STANDALONE_FUZZER`) the program runs the fuzz target for
+ *   every file in the given files and directories. We use this mode to
+ *   check the regression corpus stored in `Corpus`.
+ *
+ * If you set one of the environment variables below, then the fuzz target
+ * aborts (and libFuzzer reports a crash), as soon as an input needs more
+ * resources than specified:
+ *
+ * - `YANLR_FUZZ_MAX_NANOSECONDS_PER_BYTE`: parsing time per input byte
+ * - `YANLR_FUZZ_MAX_ALLOCATIONS_PER_BYTE`: calls of `operator new` per input
+ *   byte
+ * - `YANLR_FUZZ_MAX_SLOWDOWN`: factor for the limits above, if they are not
+ *   set explicitly. The fuzz target multiplies the factor with the resources
+ *   per byte it needs to parse a (linear) reference document. This way the
+ *   limits fit the speed of the machine and the sanitizers of the build.
+ */
+
+// -- Imports ------------------------------------------------------------------
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include "Corpus.hpp"
+#include "Parser.hpp"
+
+using std::atomic;
+using std::bad_alloc;
+using std::cerr;
+using std::endl;
+using std::sort;
+using std::vector;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+using std::chrono::steady_clock;
+
+using antlr4::RuntimeException;
+
+// -- Allocations --------------------------------------------------------------
+
+namespace {
+
+/** This counter stores the number of calls to `operator new`. */
+atomic<size_t> allocations{0};
+
+} // namespace
+
+void *operator new(size_t size) {
+  allocations++;
+  if (void *memory = malloc(size > 0 ? size : 1)) {
+    return memory;
+  }
+  throw bad_alloc{};
+}
+
+void operator delete(void *memory) noexcept { free(memory); }
+
+// -- Functions ----------------------------------------------------------------
+
+namespace {
+
+/**
+ * This constant specifies a number of bytes we add to the size of every
+ * input, before we calculate resource usage per byte. This way the (constant)
+ * setup cost of a parse does not trigger the limits for tiny inputs.
+ */
+size_t const BASE_SIZE = 64;
+
+/**
+ * This constant specifies the number of lines of the reference document. Each
+ * line contains a short plain scalar inside a block sequence, since inputs
+ * with many tokens per byte are the most expensive ones that still scale
+ * linearly.
+ */
+size_t const REFERENCE_LINES = 4096;
+
+/** This structure stores the resources used to parse an input. */
+struct Usage {
+  /** This number stores the parsing time in nanoseconds. */
+  double nanoseconds;
+  /** This number stores the number of calls to `operator new`. */
+  double allocations;
+};
+
+/**
+ * @brief This function reads a resource limit from the environment.
+ *
+ * @param name This parameter specifies the name of the environment variable
+ *             that stores the limit.
+ *
+ * @return The value of the limit or `0`, if the variable does not exist
+ */
+double limit(char const *name) {
+  char const *value = getenv(name);
+  return value == nullptr ? 0 : strtod(value, nullptr);
+}
+
+/**
+ * @brief This function aborts the program, if the given resource usage is
+ *        larger than the specified limit.
+ *
+ * @param resource This parameter stores a description of the resource.
+ * @param usage This number specifies the amount of the resource used to
+ *              parse the input.
+ * @param perByteLimit This number specifies the maximum amount of the
+ *                     resource the parser may use per input byte. The value
+ *                     `0` disables the check.
+ * @param size This number stores the size of the input in bytes.
+ */
+void checkLimit(char const *resource, double const usage,
+                double const perByteLimit, size_t const size) {
+  if (perByteLimit <= 0 || usage <= perByteLimit * (size + BASE_SIZE)) {
+    return;
+  }
+  cerr << "Slow unit: Parsing " << size << " bytes took " << usage << " "
+       << resource << " (limit: " << perByteLimit << " per byte)" << endl;
+  abort();
+}
+
+/**
+ * @brief This function parses the given input and measures the used
+ *        resources.
+ *
+ * @param text This parameter stores the input.
+ *
+ * @return The resources the parser used for `text`
+ */
+Usage parse(string text) {
+  static Parser parser{};
+
+  size_t const allocationsBefore = allocations;
+  auto const start = steady_clock::now();
+
+  try {
+    parser.parse(move(text), CppKey{"user", KEY_END});
+  } catch (RuntimeException const &) {
+    // Rejecting invalid input is fine. We only look for crashes, hangs and
+    // excessive resource usage.
+  }
+
+  auto const time = duration_cast<nanoseconds>(steady_clock::now() - start);
+  return {static_cast<double>(time.count()),
+          static_cast<double>(allocations - allocationsBefore)};
+}
+
+/**
+ * @brief This function determines the resource limits per input byte.
+ *
+ * @return The limits specified in the environment, or the limits derived
+ *         from the reference document and `YANLR_FUZZ_MAX_SLOWDOWN`
+ */
+Usage calibrate() {
+  Usage maximum{limit("YANLR_FUZZ_MAX_NANOSECONDS_PER_BYTE"),
+                limit("YANLR_FUZZ_MAX_ALLOCATIONS_PER_BYTE")};
+  double const slowdown = limit("YANLR_FUZZ_MAX_SLOWDOWN");
+  if (slowdown <= 0) {
+    return maximum;
+  }
+
+  string reference;
+  for (size_t line = 0; line < REFERENCE_LINES; line++) {
+    reference += "- a\n";
+  }
+  // The first parse fills the caches of the grammar parser
+  parse(reference);
+  Usage const usage = parse(reference);
+  double const bytes = reference.size() + BASE_SIZE;
+
+  if (maximum.nanoseconds <= 0) {
+    maximum.nanoseconds = slowdown * usage.nanoseconds / bytes;
+  }
+  if (maximum.allocations <= 0) {
+    maximum.allocations = slowdown * usage.allocations / bytes;
+  }
+  cerr << "Limits per byte: " << maximum.nanoseconds << " nanoseconds, "
+       << maximum.allocations << " allocations" << endl;
+  return maximum;
+}
+
+/**
+ * @brief This function returns the paths of all regular files stored at the
+ *        given location.
+ *
+ * @param path This parameter specifies a file or directory.
+ *
+ * @return A sorted list containing `path`, if `path` is a file, or all
+ *         (regular) files inside `path`, if `path` is a directory
+ */
+vector<string> listFiles(string const &path) {
+  DIR *directory = opendir(path.c_str());
+  if (directory == nullptr) {
+    return {path};
+  }
+
+  vector<string> files;
+  while (dirent *entry = readdir(directory)) {
+    string filepath = path + "/" + entry->d_name;
+    struct stat status;
+    if (stat(filepath.c_str(), &status) == 0 && S_ISREG(status.st_mode)) {
+      files.push_back(filepath);
+    }
+  }
+  closedir(directory);
+  sort(files.begin(), files.end());
+  return files;
+}
+
+} // namespace
+
+// -- Fuzz Target --------------------------------------------------------------
+
+extern "C" int LLVMFuzzerTestOneInput(uint8_t const *data, size_t size) {
+  static Usage const maximum = calibrate();
+
+  Usage const usage =
+      parse(string{reinterpret_cast<char const *>(data), size});
+
+  checkLimit("nanoseconds", usage.nanoseconds, maximum.nanoseconds, size);
+  checkLimit("allocations", usage.allocations, maximum.allocations, size);
+  return 0;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+#ifdef STANDALONE_FUZZER
+int main(int argc, char const *argv[]) {
+  for (int argument = 1; argument < argc; argument++) {
+    for (auto const &filename : listFiles(argv[argument])) {
+      cerr << "• Test file “" << filename << "”" << endl;
+      string text = readFile(filename);
+      // We only check the second run, since the first run of a new kind of
+      // input also fills the caches of the grammar parser.
+      parse(text);
+      LLVMFuzzerTestOneInput(reinterpret_cast<uint8_t const *>(text.data()),
+                             text.size());
+    }
+  }
+  return EXIT_SUCCESS;
+}
+#endif
@@ -0,0 +1,59 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::ostringstream;
+
+using antlr4::RuntimeException;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  struct {
+    string yaml;
+    string json;
+  } const cases[] = {
+      {"", "null\n"},
+      {"scalar\n", "\"scalar\"\n"},
+      {"key: value\n", "{\"key\":\"value\"}\n"},
+      {"a: 1\nb: true\nc: ~\nd: 1.5\ne: '2'\nf:\n",
+       "{\"a\":1,\"b\":true,\"c\":null,\"d\":1.5,\"e\":\"2\",\"f\":null}\n"},
+      // Floats keep their text, if it is a valid JSON number
+      {"- 0.1\n- 1e3\n- -.5\n- 2.\n- +0.25\n", "[0.1,1e3,-0.5,2,0.25]\n"},
+      // Mappings keep the order of their keys
+      {"z: 1\na: 2\n", "{\"z\":1,\"a\":2}\n"},
+      {"- 1\n-\n  - 2\n  - 3\n- key: value\n",
+       "[1,[2,3],{\"key\":\"value\"}]\n"},
+      {"key: 'say \"hi\"'\n", "{\"key\":\"say \\\"hi\\\"\"}\n"},
+      {"a: &x 1\nb: *x\n", "{\"a\":1,\"b\":1}\n"},
+      {"base: &b\n  x: 1\ncopy: *b\nmerged:\n  <<: *b\n  y: 2\n",
+       "{\"base\":{\"x\":1},\"copy\":{\"x\":1},\"merged\":{\"x\":1,\"y\":2}}\n"},
+      {"key: *unknown\n", "1:6 Unknown alias “unknown”"},
+  };
+
+  Parser parser{};
+  bool failed = false;
+  for (auto const &test : cases) {
+    ostringstream output;
+    string json;
+    try {
+      parser.toJSON(test.yaml, output);
+      json = output.str();
+    } catch (RuntimeException const &error) {
+      json = error.what();
+    }
+    if (json != test.json) {
+      cerr << "Converting" << endl
+           << test.yaml << "returned" << endl
+           << json << "instead of" << endl
+           << test.json << endl;
+      failed = true;
+    }
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,49 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Corpus.hpp"
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  if (argc != 2) {
+    cerr << "Usage: " << argv[0] << " directory" << endl;
+    return EXIT_FAILURE;
+  }
+
+  Parser parser{};
+  bool failed = false;
+  for (auto const &filename : listYAMLFiles(argv[1])) {
+    string text = readFile(filename);
+    CppKeySet expected = parser.parse(text, CppKey{"user", KEY_END});
+    KeyTree tree = parser.parseKeyTree(text, "user");
+
+    string difference = compare(expected, tree.keySet(), {"array"});
+    for (auto const &key : expected) {
+      if (!difference.empty()) {
+        break;
+      }
+      // Every key must be reachable, and the key set for its subtree has to
+      // contain the key itself
+      KeyTree::Node node = tree.lookup(key.getName());
+      if (node == KeyTree::NONE || !tree.isKey(node) ||
+          tree.name(node) != key.getName() ||
+          !tree.keySet(node).lookup(key.getName())) {
+        difference = "Lookup of key “" + key.getName() + "” failed";
+      }
+    }
+
+    if (!difference.empty()) {
+      cerr << "“" << filename << "”: " << difference << endl;
+      failed = true;
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
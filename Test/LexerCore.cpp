@@ -0,0 +1,156 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cstdio>
+#include <iostream>
+
+#include "Corpus.hpp"
+#include "StreamInputStream.hpp"
+#include "UTF8InputStream.hpp"
+#include "YAMLLexer.hpp"
+
+using std::cerr;
+using std::endl;
+using std::make_shared;
+using std::to_string;
+using std::vector;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a sequence with the given number of entries.
+ *
+ * @param entries This number specifies the number of elements.
+ *
+ * @return A string containing YAML data that spans many chunks of a
+ *         `StreamInputStream`
+ */
+string sequence(size_t const entries) {
+  string text;
+  for (size_t entry = 0; entry < entries; entry++) {
+    string const number = to_string(entry);
+    text += "- key" + number + ": 'value " + number + "' # comment\n";
+    text += "  nested:\n    - \"multi\n      line " + number + "\"\n";
+    text += "  # indented comment\n  plain: &anchor" + number + " text\n";
+  }
+  return text;
+}
+
+/**
+ * @brief This function stores data in a temporary file.
+ *
+ * @param data This parameter stores the content of the file.
+ *
+ * @return A file positioned at the start of `data`, which the system removes
+ *         after the caller closed it
+ */
+FILE *temporaryFile(string const &data) {
+  FILE *file = tmpfile();
+  fwrite(data.data(), 1, data.size(), file);
+  fflush(file);
+  rewind(file);
+  return file;
+}
+
+/**
+ * @brief This function converts the tokens of a lexer to text.
+ *
+ * @param lexer This parameter stores the lexer that produces the tokens.
+ *
+ * @return A string containing the type, start, stop and channel of every
+ *         token, followed by the error message of the lexer, if it rejected
+ *         the input
+ */
+string describe(YAMLLexer &lexer) {
+  string output;
+  try {
+    for (auto token = lexer.nextToken();; token = lexer.nextToken()) {
+      output += to_string(token->getType()) + " " +
+                to_string(token->getStartIndex()) + " " +
+                to_string(token->getStopIndex()) + " " +
+                to_string(token->getChannel()) + "\n";
+      if (token->getType() == Token::EOF) {
+        break;
+      }
+    }
+  } catch (RuntimeException const &error) {
+    output += error.what();
+  }
+  return output;
+}
+
+/**
+ * @brief This function returns the tokens of the lexer core that reads the
+ *        buffer of a `UTF8InputStream`.
+ *
+ * @param text This parameter stores the scanned YAML data.
+ * @param mode This parameter specifies how the lexer handles comments.
+ *
+ * @return A textual representation of the tokens (see `describe`)
+ */
+string buffered(string const &text, CommentMode const mode) {
+  UTF8InputStream input{text};
+  YAMLLexer lexer{&input};
+  lexer.setCommentMode(mode);
+  return describe(lexer);
+}
+
+/**
+ * @brief This function returns the tokens of the lexer core that reads a
+ *        `StreamInputStream` through the `CharStream` interface.
+ *
+ * @param text This parameter stores the scanned YAML data.
+ * @param mode This parameter specifies how the lexer handles comments.
+ *
+ * @return A textual representation of the tokens (see `describe`)
+ */
+string streamed(string const &text, CommentMode const mode) {
+  FILE *file = temporaryFile(text);
+  string output;
+  {
+    StreamInputStream input{fileno(file), "test"};
+    YAMLLexer lexer{&input};
+    // The stream drops data the lexer already read
+    lexer.setTokenFactory(make_shared<PositionTokenFactory>(true));
+    lexer.setCommentMode(mode);
+    output = describe(lexer);
+  }
+  fclose(file);
+  return output;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  if (argc != 2) {
+    cerr << "Usage: " << argv[0] << " directory" << endl;
+    return EXIT_FAILURE;
+  }
+
+  vector<string> names = listYAMLFiles(argv[1]);
+  vector<string> texts = readYAMLFiles(argv[1]);
+  names.push_back("long sequence");
+  texts.push_back(sequence(2000));
+  names.push_back("unterminated scalar");
+  texts.push_back(sequence(100) + "- \"unterminated\n");
+
+  bool failed = false;
+  for (size_t index = 0; index < texts.size(); index++) {
+    for (auto const mode :
+         {CommentMode::DROP, CommentMode::HIDDEN, CommentMode::PRESERVE}) {
+      string const expected = buffered(texts[index], mode);
+      string const actual = streamed(texts[index], mode);
+      if (actual != expected) {
+        cerr << "The lexer cores disagree on “" << names[index] << "”"
+             << endl
+             << "Buffer input:" << endl
+             << expected << endl
+             << "Stream input:" << endl
+             << actual << endl;
+        failed = true;
+      }
+    }
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,104 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::to_string;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates nested mappings with the given depth.
+ *
+ * @param depth This number specifies the number of nested mappings.
+ *
+ * @return A string containing YAML data with a single key at level `depth`
+ */
+string mappings(size_t const depth) {
+  string text;
+  for (size_t level = 0; level < depth; level++) {
+    text += string(level * 2, ' ') + "level" + to_string(level) + ":\n";
+  }
+  return text + string(depth * 2, ' ') + "key: value\n";
+}
+
+/**
+ * @brief This function creates a mapping with the given number of keys.
+ *
+ * @param count This number specifies the number of key-value pairs.
+ *
+ * @return A string containing YAML data with `count` top level keys
+ */
+string pairs(size_t const count) {
+  string text;
+  for (size_t number = 0; number < count; number++) {
+    text += "key" + to_string(number) + ": " + to_string(number) + "\n";
+  }
+  return text;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  Limits depth;
+  depth.depth = 3;
+  Limits queue;
+  queue.queue = 2;
+  Limits scalarBytes;
+  scalarBytes.scalarBytes = 10;
+  Limits keys;
+  keys.keys = 10;
+  Limits deadline;
+  deadline.deadline =
+      std::chrono::steady_clock::now() - std::chrono::seconds(1);
+
+  struct {
+    Limits limits;
+    string text;
+    string error;
+  } const cases[] = {
+      {depth, mappings(2), ""},
+      {depth, mappings(5), "Nesting depth exceeds the limit of 3"},
+      {queue, "key: value\n", "Token queue exceeds the limit of 2 tokens"},
+      {scalarBytes, "key: value\n", ""},
+      {scalarBytes, "key: a plain value\n",
+       "Scalar exceeds the limit of 10 bytes"},
+      {scalarBytes, "key: \"a quoted value\"\n",
+       "Scalar exceeds the limit of 10 bytes"},
+      {keys, pairs(5), ""},
+      {keys, pairs(20), "Number of keys exceeds the limit of 10"},
+      {deadline, "key: value\n", ""},
+      {deadline, pairs(1000), "exceeded the deadline"},
+  };
+
+  bool failed = false;
+  for (auto const &test : cases) {
+    Parser parser{};
+    parser.setLimits(test.limits);
+    for (size_t method = 0; method < 2; method++) {
+      string error;
+      try {
+        if (method == 0) {
+          parser.parse(test.text, CppKey{"user", KEY_END});
+        } else {
+          parser.parseKeyTree(test.text, "user");
+        }
+      } catch (RuntimeException const &exception) {
+        error = exception.what();
+      }
+      if (test.error.empty() ? !error.empty()
+                             : error.find(test.error) == string::npos) {
+        cerr << "Parsing" << endl
+             << test.text << "returned the error “" << error
+             << "” instead of “" << test.error << "”" << endl;
+        failed = true;
+      }
+    }
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  struct {
+    vector<string> layers;
+    string keys;
+  } const cases[] = {
+      {{"a: 1\nb:\n  c: 2\n  d: 3\n", "b:\n  c: 4\n"},
+       "user/a: 1\nuser/b/c: 4\nuser/b/d: 3\n"},
+      {{"a: 1\nb: 1\nc: 1\n", "b: 2\n", "c: 3\n"},
+       "user/a: 1\nuser/b: 2\nuser/c: 3\n"},
+      // Sequences replace the whole sequence of earlier layers
+      {{"list:\n  - a\n  - b\n  - c\n", "list:\n  - x\n"},
+       "user/list:\nuser/list/#0: x\n"},
+      {{"key:\n  x: 1\n", "key: 2\n"}, "user/key: 2\n"},
+      {{"key:\n  x: 1\n", "key:\n"}, "user/key:\n"},
+      {{"key: 1\n", "key:\n  x: 2\n"}, "user/key/x: 2\n"},
+      // Mappings also replace empty values
+      {{"key:\n", "key:\n  x: 2\n"}, "user/key/x: 2\n"},
+      {{"key: ~\n", "key:\n  x: 2\n"}, "user/key/x: 2\n"},
+      {{"key:\n  - 1\n", "key:\n  x: 2\n"}, "user/key/x: 2\n"},
+      {{"a: 1\n", ""}, "user/a: 1\n"},
+      {{"a: 1\n", "scalar\n"}, "user: scalar\n"},
+      {{"a:\n  b: 1\n", "a:\n  c: &x 2\n  d: *x\n"},
+       "user/a/b: 1\nuser/a/c: 2\nuser/a/d: 2\n"},
+  };
+
+  Parser parser{};
+  bool failed = false;
+  for (auto const &test : cases) {
+    parser.resetLayers(CppKey{"user", KEY_END});
+    for (auto const &layer : test.layers) {
+      parser.addLayer(layer);
+    }
+    string keys;
+    for (auto const &key : parser.layers()) {
+      keys += key.getName() + ":" +
+              (key.getStringSize() > 1 ? " " + key.getString() : "") + "\n";
+    }
+    if (keys != test.keys) {
+      cerr << "Merging" << endl;
+      for (auto const &layer : test.layers) {
+        cerr << layer << "—" << endl;
+      }
+      cerr << "returned" << endl
+           << keys << "instead of" << endl
+           << test.keys << endl;
+      failed = true;
+    }
+  }
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
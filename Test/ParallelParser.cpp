@@ -0,0 +1,123 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Corpus.hpp"
+#include "ParallelParser.hpp"
+
+using std::cerr;
+using std::endl;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a mapping with many top level keys.
+ *
+ * The values contain nested collections, comments and quoted scalars that
+ * span multiple lines and contain text that looks like a top level key.
+ *
+ * @param entries This number specifies the number of top level keys.
+ *
+ * @return A string containing YAML data
+ */
+string inventory(size_t const entries) {
+  string text = "# Inventory\n";
+  for (size_t entry = 0; entry < entries; entry++) {
+    string const number = to_string(entry);
+    text += "# Host " + number + "\n\n";
+    text += "host" + number + ":\n";
+    text += "  name: 'server " + number + "'\n";
+    text += "  roles:\n    - web\n    - db: primary\n";
+    text += "  # Comment\n";
+    text += "  notes: \"first line\nfake" + number + ": key\"\n";
+    text += "'quoted key " + number + "': value # comment\n";
+  }
+  return text;
+}
+
+/**
+ * @brief This function converts YAML data to a textual representation of the
+ *        resulting key set.
+ *
+ * @param parse This parameter stores a function that converts YAML data to a
+ *              key set.
+ * @param text This parameter stores the converted YAML data.
+ *
+ * @return A string containing the name, value and comments of every key or
+ *         the error message produced by `parse`
+ */
+template <typename Function> string toString(Function parse, string text) {
+  try {
+    return toString(parse(text), true);
+  } catch (RuntimeException const &error) {
+    return error.what();
+  }
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  vector<string> texts = argc > 1 ? readYAMLFiles(argv[1]) : vector<string>{};
+  texts.push_back(inventory(1000));
+  texts.push_back(inventory(10) + "invalid: 'unterminated\n");
+  texts.push_back(inventory(10) + "- not a key\n" + inventory(10));
+  // The duplicate keys end up in different chunks
+  texts.push_back(inventory(1000) + inventory(1));
+
+  // Comments in front of a key belong to the chunk of this key
+  texts.push_back("a: 1\n# about b\nb: 2\n");
+  texts.push_back("a:\n  - 1\n  # nested\n\n# about b\n\nb: 2\nc: 3\n");
+
+  Parser sequential{};
+  ParallelParser parallel{4};
+  CppKey const parent{"user", KEY_END};
+
+  bool failed = false;
+  for (auto const mode : {CommentMode::HIDDEN, CommentMode::PRESERVE}) {
+    sequential.setCommentMode(mode);
+    parallel.setCommentMode(mode);
+    for (auto const &text : texts) {
+      string expected = toString(
+          [&](string const &data) { return sequential.parse(data, parent); },
+          text);
+      string actual = toString(
+          [&](string const &data) { return parallel.parse(data, parent); },
+          text);
+      if (actual != expected) {
+        cerr << "The parallel parser returned a different result for the "
+                "input"
+             << endl
+             << text.substr(0, 200) << endl;
+        failed = true;
+      }
+    }
+  }
+
+  // Every chunk stays below the key limit, while the whole document does not
+  Limits limits;
+  limits.keys = 5000;
+  sequential.setLimits(limits);
+  parallel.setLimits(limits);
+  string const text = inventory(1000);
+  string const expected = toString(
+      [&](string const &data) { return sequential.parse(data, parent); },
+      text);
+  string const actual = toString(
+      [&](string const &data) { return parallel.parse(data, parent); }, text);
+  if (expected.find("exceeds the limit") == string::npos ||
+      actual != expected) {
+    cerr << "The parallel parser did not apply the key limit to the whole "
+            "document"
+         << endl;
+    failed = true;
+  }
+
+  if (ParallelParser::topLevelKeys(inventory(3)).size() != 6) {
+    cerr << "Unable to find all top level keys" << endl;
+    failed = true;
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
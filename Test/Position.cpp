@@ -0,0 +1,63 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "UTF8InputStream.hpp"
+#include "YAMLLexer.hpp"
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  // The second line contains multi-byte characters in front of the value.
+  // The double quoted scalar spans two lines.
+  UTF8InputStream input{"key: value\n"
+                        "ключ: значение\n"
+                        "- \"one\n"
+                        "two\" # ☺\n"};
+  YAMLLexer lexer{&input};
+
+  struct {
+    string text;
+    size_t line;
+    size_t column;
+  } const expected[] = {
+      {"key", 1, 1},      {"value", 1, 6},       {"ключ", 2, 1},
+      {"значение", 2, 7}, {"\"one\ntwo\"", 3, 3}, {"# ☺", 4, 6},
+  };
+
+  vector<unique_ptr<Token>> scalars;
+  for (auto token = lexer.nextToken(); token->getType() != Token::EOF;
+       token = lexer.nextToken()) {
+    if (token->getType() == YAMLLexer::PLAIN_SCALAR ||
+        token->getType() == YAMLLexer::DOUBLE_QUOTED_SCALAR ||
+        token->getType() == YAMLLexer::COMMENT) {
+      scalars.push_back(move(token));
+    }
+  }
+
+  bool failed = false;
+  size_t index = 0;
+  for (auto const &position : expected) {
+    if (index >= scalars.size()) {
+      cerr << "Missing token “" << position.text << "”" << endl;
+      failed = true;
+      break;
+    }
+    auto const &token = scalars[index++];
+    if (token->getText() != position.text ||
+        token->getLine() != position.line ||
+        token->getCharPositionInLine() != position.column) {
+      cerr << "Expected “" << position.text << "” at " << position.line << ":"
+           << position.column << ", but found “" << token->getText()
+           << "” at " << token->getLine() << ":"
+           << token->getCharPositionInLine() << endl;
+      failed = true;
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
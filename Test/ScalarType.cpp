@@ -0,0 +1,110 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <cmath>
+#include <iostream>
+
+#include "Parser.hpp"
+#include "ScalarType.hpp"
+
+using std::cerr;
+using std::endl;
+using std::isinf;
+using std::isnan;
+
+using antlr4::RuntimeException;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  struct {
+    string text;
+    ScalarType type;
+    double value;
+  } const cases[] = {
+      {"", ScalarType::NULL_VALUE, 0},
+      {"~", ScalarType::NULL_VALUE, 0},
+      {"Null", ScalarType::NULL_VALUE, 0},
+      {"nULL", ScalarType::STRING, 0},
+      {"true", ScalarType::BOOLEAN, 1},
+      {"FALSE", ScalarType::BOOLEAN, 0},
+      {"yes", ScalarType::STRING, 0},
+      {"42", ScalarType::INTEGER, 42},
+      {"-17", ScalarType::INTEGER, -17},
+      {"+3", ScalarType::INTEGER, 3},
+      {"0x1F", ScalarType::INTEGER, 31},
+      {"0o17", ScalarType::INTEGER, 15},
+      {"0o19", ScalarType::STRING, 0},
+      {"-0x1", ScalarType::STRING, 0},
+      {"-9223372036854775808", ScalarType::INTEGER, -9223372036854775807.0 - 1},
+      {"9223372036854775808", ScalarType::FLOAT, 9223372036854775808.0},
+      {"1.5", ScalarType::FLOAT, 1.5},
+      {"-.5", ScalarType::FLOAT, -0.5},
+      {"2.", ScalarType::FLOAT, 2},
+      {"1e3", ScalarType::FLOAT, 1000},
+      {"1e", ScalarType::STRING, 0},
+      {".", ScalarType::STRING, 0},
+      {"-", ScalarType::STRING, 0},
+      {"1_000", ScalarType::STRING, 0},
+      {"12 monkeys", ScalarType::STRING, 0},
+      {"-.inf", ScalarType::FLOAT, -HUGE_VAL},
+      {".Inf", ScalarType::FLOAT, HUGE_VAL},
+      {".NaN", ScalarType::FLOAT, NAN},
+      {".nan", ScalarType::FLOAT, NAN},
+      {".NAN", ScalarType::FLOAT, NAN},
+      {".Nan", ScalarType::STRING, 0},
+  };
+
+  bool failed = false;
+  for (auto const &test : cases) {
+    ResolvedScalar const scalar = resolveScalar(test.text);
+    double value = scalar.type == ScalarType::BOOLEAN
+                       ? scalar.boolean
+                       : scalar.type == ScalarType::INTEGER
+                             ? static_cast<double>(scalar.integer)
+                             : scalar.type == ScalarType::FLOAT
+                                   ? scalar.floating
+                                   : 0;
+    bool const sameValue = isnan(test.value) ? isnan(value)
+                                             : value == test.value ||
+                                                   (isinf(value) &&
+                                                    isinf(test.value) &&
+                                                    (value < 0) ==
+                                                        (test.value < 0));
+    if (scalar.type != test.type || !sameValue) {
+      cerr << "Unexpected type or value for “" << test.text << "”" << endl;
+      failed = true;
+    }
+  }
+
+  // Quoted scalars stay strings
+  Parser parser{};
+  parser.setTypeResolution(TypeResolution::BINARY);
+  CppKeySet keys;
+  try {
+    keys = parser.parse("plain: 42\nquoted: '42'\nnothing: ~\n",
+                        CppKey{"user", KEY_END});
+  } catch (RuntimeException const &error) {
+    cerr << "Unable to parse input: " << error.what() << endl;
+    return EXIT_FAILURE;
+  }
+
+  CppKey plain = keys.lookup("user/plain");
+  CppKey quoted = keys.lookup("user/quoted");
+  CppKey nothing = keys.lookup("user/nothing");
+  if (!plain || plain.getMeta<string>("type") != "long_long" ||
+      plain.getBinarySize() != sizeof(int64_t) ||
+      *static_cast<int64_t const *>(plain.getValue()) != 42) {
+    cerr << "Expected a binary integer for “user/plain”" << endl;
+    failed = true;
+  }
+  if (!quoted || quoted.hasMeta("type") || quoted.getString() != "42") {
+    cerr << "Expected the string “42” for “user/quoted”" << endl;
+    failed = true;
+  }
+  if (!nothing || !nothing.isBinary() || nothing.getBinarySize() != 0) {
+    cerr << "Expected a null value for “user/nothing”" << endl;
+    failed = true;
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,69 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Corpus.hpp"
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::vector;
+
+using antlr4::RuntimeException;
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  string const database = "db:\n"
+                          "  - host: one.example.com\n"
+                          "    port: 1\n"
+                          "  - host: 'two.example.com'\n"
+                          "    port: 2\n"
+                          "cache:\n"
+                          "  size: 42\n"
+                          "  # Comment\n"
+                          "  policy: \"lru\"\n";
+  string const sequence = "- a: 1\n"
+                          "  b: 2\n"
+                          "- a: 3\n"
+                          "  b: 4\n";
+
+  struct {
+    string text;
+    vector<string> names;
+    string expected;
+  } const cases[] = {
+      {database, {"user/db/#1/host"}, "user/db/#1/host: two.example.com\n"},
+      {database,
+       {"user/cache/policy", "user/db/#0/port"},
+       "user/cache/policy: lru\nuser/db/#0/port: 1\n"},
+      {database,
+       {"user/cache"},
+       "user/cache/policy: lru\nuser/cache/size: 42\n"},
+      {database, {"user/missing"}, ""},
+      {sequence, {"user/#1/a"}, "user/#1/a: 3\n"},
+      // The lexer stops after the requested key, so it never sees the
+      // unterminated scalar
+      {"first: 1\nsecond: 'unterminated\n", {"user/first"}, "user/first: 1\n"},
+  };
+
+  Parser parser{};
+  bool failed = false;
+  for (auto const &test : cases) {
+    string actual;
+    try {
+      actual = toString(
+          parser.select(test.text, CppKey{"user", KEY_END}, test.names));
+    } catch (RuntimeException const &error) {
+      actual = error.what();
+    }
+    if (actual != test.expected) {
+      cerr << "Selecting “" << test.names.front() << "” returned" << endl
+           << actual << "instead of" << endl
+           << test.expected << endl;
+      failed = true;
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+#include <thread>
+
+#include "SnapshotStore.hpp"
+
+using std::cerr;
+using std::endl;
+using std::thread;
+
+using antlr4::IllegalStateException;
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function checks if the current tree of a store maps a key to
+ *        the expected value.
+ *
+ * @param reader This parameter stores a reader of the checked store.
+ * @param name This parameter specifies the name of the checked key.
+ * @param expected This parameter stores the expected value of the key.
+ *
+ * @retval true If the key stores the expected value
+ *         false Otherwise
+ */
+bool check(SnapshotStore::Reader &reader, string const &name,
+           string const &expected) {
+  string value;
+  if (!reader.lookup(name, value) || value != expected) {
+    cerr << "Expected “" << name << "” to store “" << expected << "”, got “"
+         << value << "”" << endl;
+    return false;
+  }
+  return true;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  bool failed = false;
+  SnapshotStore store{"a: 1\nb: 1\n", "user"};
+
+  {
+    SnapshotStore::Reader reader = store.reader();
+    failed |= !check(reader, "user/a", "1");
+
+    store.reload("a: 2\nb: 2\n");
+    failed |= !check(reader, "user/a", "2");
+
+    // Readers keep the old tree, if the new data is invalid
+    try {
+      store.reload("a: [");
+      cerr << "Reloading invalid data did not fail" << endl;
+      failed = true;
+    } catch (RuntimeException const &) {
+    }
+    failed |= !check(reader, "user/b", "2");
+
+    // A view keeps its tree, while the store publishes newer trees
+    SnapshotStore::View const view = reader.view();
+    store.reload("a: 3\nb: 3\n");
+    if (view->value(view->lookup("user/a")) != "2") {
+      cerr << "A view did not keep its tree" << endl;
+      failed = true;
+    }
+    if (store.reclaim() == 0) {
+      cerr << "The store deleted a tree in use" << endl;
+      failed = true;
+    }
+  }
+  if (store.reclaim() != 0) {
+    cerr << "The store did not delete unused trees" << endl;
+    failed = true;
+  }
+
+  vector<SnapshotStore::Reader> readers;
+  try {
+    for (;;) {
+      readers.push_back(store.reader());
+    }
+  } catch (IllegalStateException const &) {
+  }
+  readers.clear();
+  store.reader();
+
+  // Each tree stores the same value for `a` and `b`, so a reader that sees
+  // different values read from a deleted or partially published tree
+  atomic<bool> torn{false};
+  vector<thread> threads;
+  for (size_t index = 0; index < 4; index++) {
+    threads.emplace_back([&store, &torn]() {
+      SnapshotStore::Reader reader = store.reader();
+      for (size_t round = 0; round < 10000; round++) {
+        SnapshotStore::View const view = reader.view();
+        if (view->value(view->lookup("user/a")) !=
+            view->value(view->lookup("user/b"))) {
+          torn = true;
+        }
+      }
+    });
+  }
+  for (size_t round = 0; round < 200; round++) {
+    string const number = to_string(round);
+    store.reload("a: " + number + "\nb: " + number + "\n");
+  }
+  for (auto &reader : threads) {
+    reader.join();
+  }
+  if (torn) {
+    cerr << "A reader saw an inconsistent tree" << endl;
+    failed = true;
+  }
+  if (store.reclaim() != 0) {
+    cerr << "The store did not delete trees after all readers finished"
+         << endl;
+    failed = true;
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
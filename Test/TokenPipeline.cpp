@@ -0,0 +1,99 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "Corpus.hpp"
+#include "Parser.hpp"
+
+using std::cerr;
+using std::endl;
+using std::to_string;
+
+using antlr4::RuntimeException;
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function creates a sequence with the given number of entries.
+ *
+ * @param entries This number specifies the number of elements.
+ *
+ * @return A string containing YAML data that produces many more tokens than
+ *         the pipeline stores at once
+ */
+string sequence(size_t const entries) {
+  string text;
+  for (size_t entry = 0; entry < entries; entry++) {
+    string const number = to_string(entry);
+    text += "- key" + number + ": 'value " + number + "' # comment\n";
+    text += "  nested:\n    - \"" + number + "\"\n";
+  }
+  return text;
+}
+
+/**
+ * @brief This function converts YAML data to a textual representation of the
+ *        resulting key set.
+ *
+ * @param parser This parameter stores the parser that converts the data.
+ * @param text This parameter stores the converted YAML data.
+ *
+ * @return A string containing the name, value and comments of every key or
+ *         the error message produced by `parser`
+ */
+string toString(Parser &parser, string const &text) {
+  try {
+    return toString(parser.parse(text, CppKey{"user", KEY_END}), true);
+  } catch (RuntimeException const &error) {
+    return error.what();
+  }
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main(int argc, char const *argv[]) {
+  vector<string> texts = argc > 1 ? readYAMLFiles(argv[1]) : vector<string>{};
+  texts.push_back(sequence(5000));
+  texts.push_back(sequence(100) + "- 'unterminated\n");
+  texts.push_back(sequence(100) + "key: value\n");
+  texts.push_back("");
+
+  Parser sequential{};
+  Parser pipelined{};
+  pipelined.setPipelined(true);
+  for (auto parser : {&sequential, &pipelined}) {
+    parser->setCommentMode(CommentMode::PRESERVE);
+  }
+
+  bool failed = false;
+  // Parsing every text twice checks that the pipeline restarts correctly,
+  // after it stopped at `EOF` or an error
+  for (size_t round = 0; round < 2; round++) {
+    for (auto const &text : texts) {
+      string expected = toString(sequential, text);
+      string actual = toString(pipelined, text);
+      if (actual != expected) {
+        cerr << "The pipelined parser returned" << endl
+             << actual.substr(0, 200) << endl
+             << "instead of" << endl
+             << expected.substr(0, 200) << endl
+             << "for the input" << endl
+             << text.substr(0, 200) << endl;
+        failed = true;
+      }
+    }
+  }
+
+  // The lexer reports this error on the producer thread
+  Limits limits;
+  limits.depth = 1;
+  pipelined.setLimits(limits);
+  string error = toString(pipelined, "a:\n  b:\n    c: d\n");
+  if (error.find("Nesting depth exceeds the limit of 1") == string::npos) {
+    cerr << "The pipelined parser returned “" << error
+         << "” instead of an error about the nesting depth" << endl;
+    failed = true;
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+// -- Imports ------------------------------------------------------------------
+
+#include <iostream>
+
+#include "UTF8InputStream.hpp"
+#include "YAMLLexer.hpp"
+
+using std::cerr;
+using std::endl;
+using std::make_shared;
+
+// -- Class --------------------------------------------------------------------
+
+/**
+ * @brief This token factory counts the number of tokens it created.
+ *
+ * The factory ignores `KEY` tokens, since the lexer creates one for every
+ * simple key candidate, and most candidates never enter the token queue.
+ */
+class CountingTokenFactory : public TokenFactory<CommonToken> {
+  /** This variable stores the factory that creates the actual tokens. */
+  CommonTokenFactory factory{};
+
+public:
+  /** This counter stores the number of tokens created by this factory. */
+  size_t created = 0;
+
+  unique_ptr<CommonToken> create(pair<TokenSource *, CharStream *> source,
+                                 size_t type, const string &text,
+                                 size_t channel, size_t start, size_t stop,
+                                 size_t line,
+                                 size_t charPositionInLine) override {
+    if (type != YAMLLexer::KEY) {
+      created++;
+    }
+    return factory.create(source, type, text, channel, start, stop, line,
+                          charPositionInLine);
+  }
+
+  unique_ptr<CommonToken> create(size_t type, const string &text) override {
+    if (type != YAMLLexer::KEY) {
+      created++;
+    }
+    return factory.create(type, text);
+  }
+};
+
+// -- Functions ----------------------------------------------------------------
+
+/**
+ * @brief This function determines the maximum number of tokens the lexer
+ *        stores at once, while it scans the given text.
+ *
+ * @param text This parameter stores the YAML data the lexer should scan.
+ *
+ * @return The maximum number of tokens (except `KEY` tokens) created, but not
+ *         yet emitted, by the lexer
+ */
+size_t peakQueueSize(string const &text) {
+  UTF8InputStream input{""};
+  YAMLLexer lexer{&input};
+  auto factory = make_shared<CountingTokenFactory>();
+  lexer.setTokenFactory(factory);
+  // The lexer creates the start token of the stream on reset, so we install
+  // the factory before we reset the lexer to the actual input
+  UTF8InputStream data{text};
+  lexer.reset(&data);
+
+  size_t emitted = 0;
+  size_t peak = 0;
+  for (auto token = lexer.nextToken(); token->getType() != Token::EOF;
+       token = lexer.nextToken()) {
+    if (token->getType() != YAMLLexer::KEY) {
+      emitted++;
+    }
+    size_t const queued = factory->created - emitted;
+    peak = queued > peak ? queued : peak;
+  }
+  return peak;
+}
+
+/**
+ * @brief This function creates a YAML document that contains the given
+ *        entry multiple times.
+ *
+ * @param prefix This parameter stores text that the document starts with.
+ * @param entry This parameter stores the repeated text.
+ * @param repetitions This number specifies how often the document contains
+ *                    `entry`.
+ *
+ * @return A string containing `prefix` followed by `repetitions` copies of
+ *         `entry`
+ */
+string repeat(string const &prefix, string const &entry,
+              size_t const repetitions) {
+  string text = prefix;
+  for (size_t repetition = 0; repetition < repetitions; repetition++) {
+    text += entry;
+  }
+  return text;
+}
+
+// -- Main ---------------------------------------------------------------------
+
+int main() {
+  struct {
+    string name;
+    string prefix;
+    string entry;
+  } const documents[] = {
+      {"sequence of plain scalars", "", "- scalar\n"},
+      {"sequence of quoted scalars", "", "- 'scalar'\n"},
+      {"nested sequence of plain scalars", "key:\n", "  - scalar value\n"},
+  };
+
+  // For these documents the lexer never needs more than a few tokens of
+  // lookahead
+  size_t const limit = 4;
+
+  bool failed = false;
+  for (auto const &document : documents) {
+    size_t small = peakQueueSize(repeat(document.prefix, document.entry, 10));
+    size_t large =
+        peakQueueSize(repeat(document.prefix, document.entry, 1000));
+    if (large > limit || small > limit) {
+      cerr << "The token queue for a " << document.name << " stored "
+           << (large > small ? large : small) << " tokens at once" << endl;
+      failed = true;
+    }
+    if (large != small) {
+      cerr << "The token queue for a " << document.name
+           << " grew with the size of the input (" << small << " tokens for 10"
+           << " entries, " << large << " tokens for 1000 entries)" << endl;
+      failed = true;
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}